@@ -0,0 +1,141 @@
+#include "AtCompressedPad.h"
+
+#include "AtAuxPad.h"
+#include "AtPad.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+
+ClassImp(AtCompressedPad);
+
+namespace {
+/// Round val to the nearest int16, saturating (and incrementing numSaturated) if it is out of range
+Short_t ClampToShort(Double_t val, Int_t &numSaturated)
+{
+   val = std::round(val);
+   if (val < std::numeric_limits<Short_t>::min() || val > std::numeric_limits<Short_t>::max()) {
+      ++numSaturated;
+      val = std::max<Double_t>(val, std::numeric_limits<Short_t>::min());
+      val = std::min<Double_t>(val, std::numeric_limits<Short_t>::max());
+   }
+   return static_cast<Short_t>(val);
+}
+
+// Deltas wrap around, so any pair of int16 values can be encoded exactly
+Short_t EncodeDelta(Short_t val, Short_t prev)
+{
+   return static_cast<Short_t>(static_cast<UShort_t>(val) - static_cast<UShort_t>(prev));
+}
+Short_t DecodeDelta(Short_t delta, Short_t prev)
+{
+   return static_cast<Short_t>(static_cast<UShort_t>(prev) + static_cast<UShort_t>(delta));
+}
+} // namespace
+
+AtCompressedPad::AtCompressedPad(const AtPad &pad, Double_t threshold, Int_t window, Double_t adcScale)
+   : fPadNum(pad.GetPadNum()), fSizeID(pad.GetSizeID()), fPadX(pad.GetPadCoord().X()), fPadY(pad.GetPadCoord().Y()),
+     fIsValid(pad.GetValidPad()), fIsPedestalSubtracted(pad.IsPedestalSubtracted()), fAdcScale(adcScale)
+{
+   if (auto auxPad = dynamic_cast<const AtAuxPad *>(&pad); auxPad != nullptr)
+      fAuxName = auxPad->GetAuxName();
+
+   const auto &raw = pad.GetRawADC();
+   const Int_t numTbs = raw.size();
+
+   // Look for signal in the calibrated trace if there is one, otherwise relative to the average raw value
+   std::array<Double_t, std::tuple_size<AtPad::trace>::value> signal{};
+   if (fIsPedestalSubtracted) {
+      signal = pad.GetADC();
+   } else {
+      Double_t mean = 0;
+      for (auto val : raw)
+         mean += val;
+      mean /= numTbs;
+      for (Int_t iTb = 0; iTb < numTbs; ++iTb)
+         signal[iTb] = raw[iTb] - mean;
+   }
+
+   std::array<Bool_t, std::tuple_size<AtPad::rawTrace>::value> keep{};
+   for (Int_t iTb = 0; iTb < numTbs; ++iTb)
+      if (signal[iTb] > threshold)
+         for (Int_t i = std::max(0, iTb - window); i <= std::min(numTbs - 1, iTb + window); ++i)
+            keep[i] = true;
+
+   // Suppressed raw samples are replaced by their average
+   Double_t baseline = 0;
+   Int_t numSuppressed = 0;
+   for (Int_t iTb = 0; iTb < numTbs; ++iTb) {
+      if (!keep[iTb]) {
+         baseline += raw[iTb];
+         numSuppressed++;
+      }
+   }
+   fRawBaseline = numSuppressed > 0 ? ClampToShort(baseline / numSuppressed, fNumSaturated) : 0;
+
+   for (Int_t iTb = 0; iTb < numTbs;) {
+      if (!keep[iTb]) {
+         ++iTb;
+         continue;
+      }
+
+      Int_t start = iTb;
+      Short_t prevRaw = fRawBaseline;
+      Short_t prevAdc = 0;
+      for (; iTb < numTbs && keep[iTb]; ++iTb) {
+         auto rawVal = ClampToShort(raw[iTb], fNumSaturated);
+         fRawDeltas.push_back(EncodeDelta(rawVal, prevRaw));
+         prevRaw = rawVal;
+
+         if (fIsPedestalSubtracted) {
+            auto adcVal = ClampToShort(signal[iTb] * fAdcScale, fNumSaturated);
+            fAdcDeltas.push_back(EncodeDelta(adcVal, prevAdc));
+            prevAdc = adcVal;
+         }
+      }
+      fWindows.push_back(start);
+      fWindows.push_back(iTb - start);
+   }
+}
+
+std::unique_ptr<AtPad> AtCompressedPad::Expand() const
+{
+   std::unique_ptr<AtPad> pad;
+   if (IsAux())
+      pad = std::make_unique<AtAuxPad>(fAuxName);
+   else
+      pad = std::make_unique<AtPad>(fPadNum);
+
+   ExpandInto(*pad);
+   return pad;
+}
+
+void AtCompressedPad::ExpandInto(AtPad &pad) const
+{
+   pad.SetPadNum(fPadNum);
+   pad.SetSizeID(fSizeID);
+   pad.SetPadCoord({fPadX, fPadY});
+   pad.SetValidPad(fIsValid);
+   pad.SetPedestalSubtracted(fIsPedestalSubtracted);
+
+   auto &raw = pad.GetRawADCBuffer();
+   auto &adc = pad.GetADCBuffer();
+   raw.fill(fRawBaseline);
+   adc.fill(0);
+
+   std::size_t sample = 0;
+   for (std::size_t iWindow = 0; iWindow + 1 < fWindows.size(); iWindow += 2) {
+      Short_t prevRaw = fRawBaseline;
+      Short_t prevAdc = 0;
+      for (Int_t iTb = fWindows[iWindow]; iTb < fWindows[iWindow] + fWindows[iWindow + 1]; ++iTb, ++sample) {
+         prevRaw = DecodeDelta(fRawDeltas[sample], prevRaw);
+         raw[iTb] = prevRaw;
+
+         if (fIsPedestalSubtracted) {
+            prevAdc = DecodeDelta(fAdcDeltas[sample], prevAdc);
+            adc[iTb] = prevAdc / fAdcScale;
+         }
+      }
+   }
+}
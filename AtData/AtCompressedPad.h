@@ -0,0 +1,64 @@
+/*
+ * Compact copy of an AtPad used to store raw events on disk (see AtCompressedRawEvent).
+ *
+ * Only samples within **window** time buckets of a sample above **threshold** are kept. The kept samples
+ * are stored as runs of int16 deltas, which compress well when the file is written. The calibrated trace
+ * is stored as round(adc * adcScale). The dense traces are only rebuilt when Expand() is called.
+ *
+ * The compression is lossy: suppressed samples come back as 0 in the calibrated trace and as the average
+ * of the suppressed samples in the raw trace, the calibrated trace is rounded to 1/adcScale, and samples
+ * outside of the int16 range are saturated (counted by GetNumSaturated()). A threshold below every sample
+ * keeps the raw trace exactly.
+ */
+#ifndef ATCOMPRESSEDPAD_H
+#define ATCOMPRESSEDPAD_H
+
+#include <Rtypes.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+class AtPad;
+class TBuffer;
+class TClass;
+class TMemberInspector;
+
+class AtCompressedPad {
+private:
+   Int_t fPadNum{-1};
+   Int_t fSizeID{-1000};
+   Double_t fPadX{-9999};
+   Double_t fPadY{-9999};
+   Bool_t fIsValid{true};
+   Bool_t fIsPedestalSubtracted{false};
+   std::string fAuxName; //< Name of the pad if it is an AtAuxPad, otherwise empty
+
+   Double_t fAdcScale{1};
+   Short_t fRawBaseline{0};         //< Value of the suppressed samples in the raw trace
+   std::vector<UShort_t> fWindows;  //< Start time bucket and length of each stored window
+   std::vector<Short_t> fRawDeltas; //< Raw samples in the windows, as differences from the previous sample
+   std::vector<Short_t> fAdcDeltas; //< Scaled calibrated samples in the windows, same encoding
+   Int_t fNumSaturated{0};          //< Number of samples clamped to the int16 range
+
+public:
+   AtCompressedPad() = default;
+   AtCompressedPad(const AtPad &pad, Double_t threshold, Int_t window, Double_t adcScale = 1);
+
+   Int_t GetPadNum() const { return fPadNum; }
+   Bool_t IsAux() const { return !fAuxName.empty(); }
+   const std::string &GetAuxName() const { return fAuxName; }
+   /// Number of samples stored per trace
+   Int_t GetNumSamples() const { return fRawDeltas.size(); }
+   /// Number of stored samples that were outside of the int16 range and were saturated
+   Int_t GetNumSaturated() const { return fNumSaturated; }
+
+   /// Create a pad (AtAuxPad if this was one) with the dense traces rebuilt
+   std::unique_ptr<AtPad> Expand() const;
+   /// Rebuild the dense traces and other data of this pad into **pad**
+   void ExpandInto(AtPad &pad) const;
+
+   ClassDef(AtCompressedPad, 2);
+};
+
+#endif //#ifndef ATCOMPRESSEDPAD_H
@@ -0,0 +1,83 @@
+#include "AtCompressedRawEvent.h"
+
+#include "AtAuxPad.h"
+#include "AtPad.h"
+#include "AtRawEvent.h"
+
+#include <cstddef>
+#include <utility>
+
+ClassImp(AtCompressedRawEvent);
+
+AtCompressedRawEvent::AtCompressedRawEvent() : TNamed("AtCompressedRawEvent", "Compressed raw event container") {}
+
+void AtCompressedRawEvent::Compress(const AtRawEvent &event, Double_t threshold, Int_t window, Double_t adcScale)
+{
+   Clear();
+   fEventID = event.GetEventID();
+   fTimestamp = event.GetTimestamps();
+   fIsGood = event.IsGood();
+   fIsInGate = event.GetIsExtGate();
+
+   fPads.reserve(event.GetNumPads());
+   for (const auto &pad : event.GetPads())
+      fPads.emplace_back(*pad, threshold, window, adcScale);
+
+   fAuxPads.reserve(event.GetNumAuxPads());
+   for (const auto &[name, pad] : event.GetAuxPads())
+      fAuxPads.emplace_back(pad, threshold, window, adcScale);
+}
+
+void AtCompressedRawEvent::FillRawEvent(AtRawEvent &event) const
+{
+   event.Clear();
+   event.SetEventID(fEventID);
+   event.SetNumberOfTimestamps(fTimestamp.size());
+   for (std::size_t i = 0; i < fTimestamp.size(); ++i)
+      event.SetTimestamp(fTimestamp[i], i);
+   event.SetIsGood(fIsGood);
+   event.SetIsExtGate(fIsInGate);
+
+   for (const auto &pad : fPads)
+      pad.ExpandInto(*event.AddPad());
+
+   for (const auto &pad : fAuxPads)
+      pad.ExpandInto(*event.AddAuxPad(pad.GetAuxName()).first);
+}
+
+const AtPad *AtCompressedRawEvent::GetPad(Int_t padNum) const
+{
+   if (auto it = fExpandedPads.find(padNum); it != fExpandedPads.end())
+      return it->second.get();
+
+   if (fPadIndex.empty())
+      for (std::size_t i = 0; i < fPads.size(); ++i)
+         fPadIndex.emplace(fPads[i].GetPadNum(), i);
+
+   auto it = fPadIndex.find(padNum);
+   if (it == fPadIndex.end())
+      return nullptr;
+   return fExpandedPads.emplace(padNum, fPads[it->second].Expand()).first->second.get();
+}
+
+Int_t AtCompressedRawEvent::GetNumSaturated() const
+{
+   Int_t numSaturated = 0;
+   for (const auto &pad : fPads)
+      numSaturated += pad.GetNumSaturated();
+   for (const auto &pad : fAuxPads)
+      numSaturated += pad.GetNumSaturated();
+   return numSaturated;
+}
+
+void AtCompressedRawEvent::Clear(Option_t *opt)
+{
+   fEventID = -1;
+   fTimestamp.clear();
+   fIsGood = true;
+   fIsInGate = false;
+   fPads.clear();
+   fAuxPads.clear();
+   fPadIndex.clear();
+   fExpandedPads.clear();
+}
@@ -0,0 +1,70 @@
+/*
+ * Compact on-disk form of an AtRawEvent.
+ *
+ * Each pad is stored as an AtCompressedPad (zero suppressed, delta encoded int16 traces, see there for what
+ * is lost). The dense traces are not rebuilt when the event is read from disk. FillRawEvent() rebuilds every
+ * pad, while GetPad() rebuilds a pad the first time it is asked for and keeps it until the event is cleared
+ * or the next entry is read, so code looking at a few pads only pays for those.
+ * The Monte Carlo point map and the FFT of AtPadFFT pads are not stored.
+ */
+#ifndef ATCOMPRESSEDRAWEVENT_H
+#define ATCOMPRESSEDRAWEVENT_H
+
+#include "AtCompressedPad.h"
+#include "AtPad.h"
+
+#include <Rtypes.h>
+#include <TNamed.h>
+
+#include <cstddef>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+class AtRawEvent;
+class TBuffer;
+class TClass;
+class TMemberInspector;
+
+class AtCompressedRawEvent : public TNamed {
+private:
+   ULong_t fEventID = -1;
+   std::vector<ULong64_t> fTimestamp;
+   Bool_t fIsGood = true;
+   Bool_t fIsInGate = false;
+
+   std::vector<AtCompressedPad> fPads;
+   std::vector<AtCompressedPad> fAuxPads;
+
+   // Cleared by a read rule (AtDataLinkDef.h) when an entry is read into this object
+   mutable std::unordered_map<Int_t, std::size_t> fPadIndex;                //! Pad number -> index in fPads
+   mutable std::unordered_map<Int_t, std::unique_ptr<AtPad>> fExpandedPads; //! Pads rebuilt by GetPad
+
+public:
+   AtCompressedRawEvent();
+
+   /**
+    * Replace the content of this event with a compressed copy of **event**. Samples within **window**
+    * time buckets of a sample above **threshold** are kept, calibrated samples are stored in units of
+    * 1/adcScale.
+    */
+   void Compress(const AtRawEvent &event, Double_t threshold, Int_t window, Double_t adcScale = 1);
+   /// Rebuild the full event (with dense traces) into **event**
+   void FillRawEvent(AtRawEvent &event) const;
+   /// Pad **padNum**, rebuilt on the first call. Returns nullptr if it is not in the event.
+   const AtPad *GetPad(Int_t padNum) const;
+
+   void Clear(Option_t *opt = nullptr) override;
+
+   ULong_t GetEventID() const { return fEventID; }
+   Bool_t IsGood() const { return fIsGood; }
+   Int_t GetNumPads() const { return fPads.size(); }
+   const std::vector<AtCompressedPad> &GetPads() const { return fPads; }
+   const std::vector<AtCompressedPad> &GetAuxPads() const { return fAuxPads; }
+   /// Number of samples that were saturated to fit in an int16 when the event was compressed
+   Int_t GetNumSaturated() const;
+
+   ClassDefOverride(AtCompressedRawEvent, 2);
+};
+
+#endif //#ifndef ATCOMPRESSEDRAWEVENT_H
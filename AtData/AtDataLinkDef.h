@@ -9,6 +9,12 @@
 #pragma link C++ class AtAuxPad + ;
 #pragma link C++ class AtPadFFT + ;
 #pragma link C++ class AtRawEvent + ;
+#pragma read sourceClass = "AtRawEvent" targetClass = "AtRawEvent" version = "[1-]" \
+   source = "" target = "fPadIndex,fNumIndexedPads" code = "{ fPadIndex.clear(); fNumIndexedPads = 0; }"
+#pragma link C++ class AtCompressedPad + ;
+#pragma link C++ class AtCompressedRawEvent + ;
+#pragma read sourceClass = "AtCompressedRawEvent" targetClass = "AtCompressedRawEvent" version = "[1-]" \
+   source = "" target = "fPadIndex,fExpandedPads" code = "{ fPadIndex.clear(); fExpandedPads.clear(); }"
 #pragma link C++ class AtHit + ;
 #pragma link C++ class AtHitCluster + ;
 #pragma link C++ struct AtHit::MCSimPoint + ;
@@ -9,12 +9,15 @@
 #ifndef AtPAD_H
 #define AtPAD_H
 
+#include "AtPadArena.h"
+
 #include <Math/Point2D.h>
 #include <Math/Point2Dfwd.h>
 #include <Rtypes.h>
 #include <TObject.h>
 
 #include <array>
+#include <cstddef>
 #include <memory>
 
 class TBuffer;
@@ -44,6 +47,12 @@ public:
    virtual ~AtPad() = default;
    virtual std::unique_ptr<AtPad> Clone(); // Create a copy of sub-type
 
+   // Allocate through AtPadArena so an event can place its pads in one contiguous block (see AtRawEvent::AddPad)
+   static void *operator new(std::size_t size) { return AtPadArena::AllocatePad(size); }
+   static void *operator new(std::size_t, void *ptr) { return ptr; }
+   static void operator delete(void *ptr) { AtPadArena::DeallocatePad(ptr); }
+   static void operator delete(void *, void *) {}
+
    void SetValidPad(Bool_t val = kTRUE) { fIsValid = val; }
    void SetPadNum(Int_t padNum) { fPadNum = padNum; }
    void SetSizeID(Int_t sizeID) { fSizeID = sizeID; }
@@ -55,6 +64,10 @@ public:
    void SetRawADC(Int_t idx, Int_t val) { fRawAdc[idx] = val; }
    void SetADC(const trace &val) { fAdc = val; }
    void SetADC(Int_t idx, Double_t val) { fAdc[idx] = val; }
+   /// Writable traces for code that fills them in place (ex. pedestal subtraction). Does not
+   /// mark the pad as pedestal subtracted.
+   rawTrace &GetRawADCBuffer() { return fRawAdc; }
+   trace &GetADCBuffer() { return fAdc; }
 
    Bool_t IsPedestalSubtracted() const { return fIsPedestalSubtracted; }
 
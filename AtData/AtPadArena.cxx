@@ -0,0 +1,84 @@
+#include "AtPadArena.h"
+
+#include <algorithm>
+#include <new>
+
+thread_local AtPadArena *AtPadArena::fCurrentArena = nullptr;
+
+namespace {
+// Every pad is prefixed with the arena it came from (nullptr if it is on the heap)
+constexpr std::size_t kHeaderSize = alignof(std::max_align_t);
+static_assert(kHeaderSize >= sizeof(AtPadArena *), "Pad header too small to hold arena pointer");
+
+constexpr std::size_t RoundUp(std::size_t size)
+{
+   return (size + kHeaderSize - 1) / kHeaderSize * kHeaderSize;
+}
+} // namespace
+
+void *AtPadArena::AllocatePad(std::size_t size)
+{
+   AtPadArena *arena = fCurrentArena;
+   void *base = (arena == nullptr) ? ::operator new(size + kHeaderSize) : arena->Allocate(size + kHeaderSize);
+   if (arena != nullptr)
+      arena->AddRef();
+
+   *static_cast<AtPadArena **>(base) = arena;
+   return static_cast<std::byte *>(base) + kHeaderSize;
+}
+
+void AtPadArena::DeallocatePad(void *ptr) noexcept
+{
+   if (ptr == nullptr)
+      return;
+
+   void *base = static_cast<std::byte *>(ptr) - kHeaderSize;
+   AtPadArena *arena = *static_cast<AtPadArena **>(base);
+   if (arena == nullptr)
+      ::operator delete(base);
+   else
+      arena->Release();
+}
+
+void AtPadArena::Reset(Ptr &arena)
+{
+   if (!arena)
+      return;
+
+   if (!arena->IsOnlyOwner()) {
+      arena = Create();
+      return;
+   }
+
+   // Merge the blocks so a full event fits in a single allocation from now on
+   if (arena->fBlocks.size() > 1) {
+      std::size_t size = 0;
+      for (auto &block : arena->fBlocks)
+         size += block.fSize;
+      arena->fBlocks.clear();
+      arena->fBlocks.push_back({std::make_unique<std::byte[]>(size), size, 0});
+   }
+
+   for (auto &block : arena->fBlocks)
+      block.fUsed = 0;
+}
+
+void *AtPadArena::Allocate(std::size_t size)
+{
+   size = RoundUp(size);
+   if (fBlocks.empty() || fBlocks.back().fSize - fBlocks.back().fUsed < size) {
+      auto blockSize = std::max({fMinBlockSize, size, fBlocks.empty() ? 0 : 2 * fBlocks.back().fSize});
+      fBlocks.push_back({std::make_unique<std::byte[]>(blockSize), blockSize, 0});
+   }
+
+   auto &block = fBlocks.back();
+   void *ptr = block.fData.get() + block.fUsed;
+   block.fUsed += size;
+   return ptr;
+}
+
+void AtPadArena::Release()
+{
+   if (fRefCount.fetch_sub(1, std::memory_order_acq_rel) == 1)
+      delete this;
+}
@@ -0,0 +1,80 @@
+/*
+ * Block of memory that pads (and therefore their traces) of an event are allocated from.
+ *
+ * Pads created with AtRawEvent::AddPad(params...) in an event using an arena are placed one after the other
+ * in a single contiguous block instead of being allocated one by one on the heap. Pads created elsewhere and
+ * moved in with AtRawEvent::AddPad(std::unique_ptr) are not part of the block. Freeing a pad does not
+ * return memory to the system; once every pad allocated from the arena is gone the whole block is
+ * reused for the next event. The arena is reference counted by its owner and by every live pad in it,
+ * so pads moved out of the event can safely outlive it.
+ *
+ * Pads still own their traces and are owned by std::unique_ptr<AtPad>, so nothing changes for code
+ * using the pads or for ROOT I/O.
+ */
+#ifndef ATPADARENA_H
+#define ATPADARENA_H
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+class AtPadArena {
+private:
+   struct Block {
+      std::unique_ptr<std::byte[]> fData;
+      std::size_t fSize{0};
+      std::size_t fUsed{0};
+   };
+
+   std::vector<Block> fBlocks;
+   std::atomic<std::size_t> fRefCount{1};
+
+   static thread_local AtPadArena *fCurrentArena;
+   static constexpr std::size_t fMinBlockSize = 1 << 20;
+
+   AtPadArena() = default;
+   ~AtPadArena() = default;
+
+public:
+   /// Releases the reference held by an owner of the arena
+   struct Releaser {
+      void operator()(AtPadArena *arena) const { arena->Release(); }
+   };
+   using Ptr = std::unique_ptr<AtPadArena, Releaser>;
+
+   /// Sets the arena pads are allocated from on this thread while in scope
+   class Scope {
+   private:
+      AtPadArena *fPrevious;
+
+   public:
+      Scope(AtPadArena *arena) : fPrevious(fCurrentArena) { fCurrentArena = arena; }
+      ~Scope() { fCurrentArena = fPrevious; }
+      Scope(const Scope &) = delete;
+      Scope &operator=(const Scope &) = delete;
+   };
+
+   static Ptr Create() { return Ptr(new AtPadArena()); }
+
+   AtPadArena(const AtPadArena &) = delete;
+   AtPadArena &operator=(const AtPadArena &) = delete;
+
+   /**
+    * Prepare the arena to be filled with a new event. If pads allocated from **arena** are still alive
+    * it is replaced with a new one, otherwise its memory is reused (merged into a single block).
+    */
+   static void Reset(Ptr &arena);
+
+   /// Allocation functions used by AtPad::operator new and delete
+   static void *AllocatePad(std::size_t size);
+   static void DeallocatePad(void *ptr) noexcept;
+
+private:
+   void *Allocate(std::size_t size);
+   void AddRef() { fRefCount.fetch_add(1, std::memory_order_relaxed); }
+   void Release();
+   bool IsOnlyOwner() const { return fRefCount.load(std::memory_order_acquire) == 1; }
+};
+
+#endif //#ifndef ATPADARENA_H
@@ -10,6 +10,13 @@ ClassImp(AtPattern);
 
 AtPattern::AtPattern(Int_t numPoints) : fNumPoints(numPoints) {}
 
+void AtPattern::DistancesToPattern(const double *x, const double *y, const double *z, std::size_t n,
+                                   double *dist) const
+{
+   for (std::size_t i = 0; i < n; ++i)
+      dist[i] = DistanceToPattern({x[i], y[i], z[i]});
+}
+
 /**
  * @brief Fit the pattern.
  *
@@ -8,6 +8,7 @@
 
 #include <algorithm> // for max
 #include <cmath>     // for NAN
+#include <cstddef>   // for size_t
 #include <memory>
 #include <utility> // for move
 #include <vector>  // for vector
@@ -73,6 +74,18 @@ public:
     * @param[in] point Point to get the distance from.
     */
    virtual Double_t DistanceToPattern(const XYZPoint &point) const = 0;
+   /**
+    * @brief Closest distance to pattern for many points.
+    *
+    * Fills dist[i] with the distance from the point (x[i], y[i], z[i]) to the pattern. Patterns
+    * override this with loops the compiler can vectorize; the default calls DistanceToPattern for each point.
+    *
+    * @param[in] x,y,z Coordinates of the points
+    * @param[in] n Number of points
+    * @param[out] dist Distance to the pattern of each point. Must hold n values.
+    */
+   virtual void DistancesToPattern(const double *x, const double *y, const double *z, std::size_t n,
+                                   double *dist) const;
    /**
     * @brief Closest point on pattern.
     *
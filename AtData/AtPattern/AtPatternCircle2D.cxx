@@ -49,6 +49,17 @@ Double_t AtPatternCircle2D::DistanceToPattern(const XYZPoint &point) const
    return std::abs(pointToCenter.Rho() - GetRadius());
 }
 
+void AtPatternCircle2D::DistancesToPattern(const double *x, const double *y, const double *z, std::size_t n,
+                                           double *dist) const
+{
+   const double cx = fPatternPar[0], cy = fPatternPar[1], radius = fPatternPar[2];
+   for (std::size_t i = 0; i < n; ++i) {
+      double dx = x[i] - cx;
+      double dy = y[i] - cy;
+      dist[i] = std::abs(std::sqrt(dx * dx + dy * dy) - radius);
+   }
+}
+
 XYZPoint AtPatternCircle2D::ClosestPointOnPattern(const XYZPoint &point) const
 {
    auto pointToCenter = point - GetCenter();
@@ -47,6 +47,24 @@ Double_t AtPatternLine::DistanceToPattern(const XYZPoint &point) const
    return std::sqrt(dist2);
 }
 
+void AtPatternLine::DistancesToPattern(const double *x, const double *y, const double *z, std::size_t n,
+                                       double *dist) const
+{
+   // Same operations as DistanceToPattern, written out so the loop vectorizes
+   const double px = fPatternPar[0], py = fPatternPar[1], pz = fPatternPar[2];
+   const double dx = fPatternPar[3], dy = fPatternPar[4], dz = fPatternPar[5];
+   const double dirMag2 = dx * dx + dy * dy + dz * dz;
+   for (std::size_t i = 0; i < n; ++i) {
+      double vx = px - x[i];
+      double vy = py - y[i];
+      double vz = pz - z[i];
+      double nx = dy * vz - vy * dz;
+      double ny = dz * vx - vz * dx;
+      double nz = dx * vy - vx * dy;
+      dist[i] = std::sqrt((nx * nx + ny * ny + nz * nz) / dirMag2);
+   }
+}
+
 void AtPatternLine::DefinePattern(const std::vector<XYZPoint> &points)
 {
    if (points.size() != fNumPoints)
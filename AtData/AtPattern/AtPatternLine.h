@@ -35,6 +35,8 @@ public:
 
    virtual void DefinePattern(const std::vector<XYZPoint> &points) override;
    virtual Double_t DistanceToPattern(const XYZPoint &point) const override;
+   virtual void DistancesToPattern(const double *x, const double *y, const double *z, std::size_t n,
+                                   double *dist) const override;
    virtual XYZPoint ClosestPointOnPattern(const XYZPoint &point) const override;
    virtual XYZPoint GetPointAt(double z) const override;
    virtual TEveLine *GetEveLine() const override;
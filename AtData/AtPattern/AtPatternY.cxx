@@ -57,6 +57,36 @@ Double_t AtPatternY::DistanceToPattern(const XYZPoint &point) const
    return std::sqrt(minDist);
 }
 
+void AtPatternY::DistancesToPattern(const double *x, const double *y, const double *z, std::size_t n,
+                                    double *dist) const
+{
+   // Same operations as DistanceToPattern, written without branches so the loop vectorizes
+   const double px = fPatternPar[0], py = fPatternPar[1], pz = fPatternPar[2];
+   const double *d = &fPatternPar[3];
+   const double dirMag2[3] = {d[0] * d[0] + d[1] * d[1] + d[2] * d[2], d[3] * d[3] + d[4] * d[4] + d[5] * d[5],
+                              d[6] * d[6] + d[7] * d[7] + d[8] * d[8]};
+   for (std::size_t i = 0; i < n; ++i) {
+      double vx = px - x[i];
+      double vy = py - y[i];
+      double vz = pz - z[i];
+      double vecMag2 = vx * vx + vy * vy + vz * vz;
+
+      double minDist = 1000;
+      for (int line = 0; line < 3; ++line) {
+         const double *dir = d + 3 * line;
+         double nx = dir[1] * vz - vy * dir[2];
+         double ny = dir[2] * vx - vz * dir[0];
+         double nz = dir[0] * vy - vx * dir[1];
+         double lineDist2 = (nx * nx + ny * ny + nz * nz) / dirMag2[line];
+
+         bool onLine = (line == 0) ? (z[i] > pz) : (z[i] < pz);
+         double dist2 = onLine ? lineDist2 : vecMag2;
+         minDist = dist2 < minDist ? dist2 : minDist;
+      }
+      dist[i] = std::sqrt(minDist);
+   }
+}
+
 void AtPatternY::DefinePattern(const std::vector<XYZPoint> &points)
 {
    // std::cout << "making pattern" << std::endl;
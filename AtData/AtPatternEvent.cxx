@@ -2,6 +2,8 @@
 
 #include <Rtypes.h>
 
+#include <utility>
+
 ClassImp(AtPatternEvent);
 
 AtPatternEvent::AtPatternEvent() : TNamed("AtPatternEvent", "Pattern Recognition Event") {}
@@ -10,7 +12,7 @@ AtPatternEvent::~AtPatternEvent() = default;
 
 void AtPatternEvent::SetTrackCand(std::vector<AtTrack> tracks)
 {
-   fTrackCand = tracks;
+   fTrackCand = std::move(tracks);
 }
 std::vector<AtTrack> &AtPatternEvent::GetTrackCand()
 {
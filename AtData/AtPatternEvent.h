@@ -26,7 +26,7 @@ public:
 
    void SetTrackCand(std::vector<AtTrack> tracks);
    void AddTrack(const AtTrack &track) { fTrackCand.push_back(track); }
-   void AddTrack(AtTrack &&track) { fTrackCand.push_back(track); }
+   void AddTrack(AtTrack &&track) { fTrackCand.push_back(std::move(track)); }
 
    void AddNoise(AtHit hit) { fNoise.push_back(std::move(hit)); }
    const std::vector<AtHit> &GetNoiseHits() { return fNoise; }
@@ -12,6 +12,8 @@
 
 #include <FairLogger.h>
 
+#include <algorithm>
+
 ClassImp(AtRawEvent);
 
 AtRawEvent::AtRawEvent() : TNamed("AtRawEvent", "Raw event container")
@@ -21,7 +23,7 @@ AtRawEvent::AtRawEvent() : TNamed("AtRawEvent", "Raw event container")
 
 AtRawEvent::AtRawEvent(const AtRawEvent &obj)
    : fEventID(obj.fEventID), fAuxPadMap(obj.fAuxPadMap), fIsInGate(obj.fIsInGate), fSimMCPointMap(obj.fSimMCPointMap),
-     fIsGood(obj.fIsGood)
+     fIsGood(obj.fIsGood), fUsePadArena(obj.fUsePadArena)
 {
    for (const auto &pad : obj.fPadList)
       fPadList.push_back(pad->Clone());
@@ -39,6 +41,9 @@ void AtRawEvent::Clear(Option_t *opt)
 {
    fEventID = -1;
    fPadList.clear();
+   fPadIndex.clear();
+   fNumIndexedPads = 0;
+   AtPadArena::Reset(fPadArena);
    fAuxPadMap.clear();
    fTimestamp.clear();
    fSimMCPointMap.clear();
@@ -65,17 +70,28 @@ void AtRawEvent::SetTimestamp(ULong64_t timestamp, int index)
 
 void AtRawEvent::RemovePad(Int_t padNum)
 {
-   for (auto it = fPadList.begin(); it != fPadList.end(); ++it)
-      if ((*it)->GetPadNum() == padNum)
-         fPadList.erase(it);
+   auto isPad = [padNum](const AtPadPtr &pad) { return pad->GetPadNum() == padNum; };
+   fPadList.erase(std::remove_if(fPadList.begin(), fPadList.end(), isPad), fPadList.end());
+   fPadIndex.clear();
+   fNumIndexedPads = 0;
 }
 
 AtPad *AtRawEvent::GetPad(Int_t padNum)
 {
-   for (auto &pad : fPadList)
-      if (pad->GetPadNum() == padNum)
-         return pad.get();
-   return nullptr;
+   IndexNewPads();
+
+   auto it = fPadIndex.find(padNum);
+   if (it == fPadIndex.end())
+      return nullptr;
+   return fPadList[it->second].get();
+}
+
+/// Add the pads added since the last lookup to the index
+void AtRawEvent::IndexNewPads()
+{
+   fPadIndex.reserve(fPadList.size());
+   for (; fNumIndexedPads < fPadList.size(); ++fNumIndexedPads)
+      fPadIndex.emplace(fPadList[fNumIndexedPads]->GetPadNum(), fNumIndexedPads); // Keep the first of repeated numbers
 }
 
 AtPad *AtRawEvent::GetAuxPad(std::string auxName)
@@ -11,6 +11,7 @@
 #define AtRAWEVENT_H
 
 #include "AtAuxPad.h"
+#include "AtPadArena.h"
 
 #include <Rtypes.h>
 #include <TNamed.h>
@@ -21,6 +22,7 @@
 #include <memory>
 #include <string>
 #include <type_traits>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
@@ -45,6 +47,11 @@ private:
 
    std::multimap<Int_t, std::size_t> fSimMCPointMap; //<! Monte Carlo Point - Hit map for kinematics
 
+   Bool_t fUsePadArena = false;                      //! Allocate pads added with AddPad from fPadArena
+   AtPadArena::Ptr fPadArena;                        //!
+   std::unordered_map<Int_t, std::size_t> fPadIndex; //! Pad number -> index in fPadList, filled by GetPad
+   std::size_t fNumIndexedPads = 0;                  //! Number of pads in fPadList already in fPadIndex
+
    friend class AtFilterTask;
    friend class AtFilterFFT;
 
@@ -71,6 +78,10 @@ public:
    template <typename... Ts>
    AtPad *AddPad(Ts &&...params)
    {
+      if (fUsePadArena && !fPadArena)
+         fPadArena = AtPadArena::Create();
+
+      AtPadArena::Scope scope(fPadArena.get());
       fPadList.push_back(std::make_unique<AtPad>(std::forward<Ts>(params)...));
       return fPadList.back().get();
    }
@@ -96,6 +107,12 @@ public:
     * bool returned is true if insert occurred.
     */
    std::pair<AtAuxPad *, bool> AddAuxPad(std::string auxName);
+   /**
+    * @brief Get pad by its pad number.
+    *
+    * Pads added since the last call are indexed by the number they have now, so pads can be numbered after they
+    * are added (ex. AtCompressedPad::ExpandInto) but must not be renumbered after they have been looked up.
+    */
    AtPad *GetPad(Int_t padNum);
    AtPad *GetAuxPad(std::string auxPad);
 
@@ -108,6 +125,12 @@ public:
    void SetTimestamp(ULong64_t timestamp, int index = 0);
    void SetNumberOfTimestamps(int numTS) { fTimestamp.resize(numTS, 0); }
    void SetIsExtGate(Bool_t value) { fIsInGate = value; }
+   /**
+    * Place pads created by AddPad(params...) in a single block of memory owned by the event instead
+    * of allocating each one on the heap. The block is reused when the event is cleared. Pads moved in with
+    * AddPad(std::unique_ptr) keep their own allocation.
+    */
+   void SetUsePadArena(Bool_t value) { fUsePadArena = value; }
 
    // getters
    ULong_t GetEventID() const { return fEventID; }
@@ -122,6 +145,10 @@ public:
    const AuxPadMap &GetAuxPads() const { return fAuxPadMap; }
    std::multimap<Int_t, std::size_t> &GetSimMCPointMap() { return fSimMCPointMap; }
 
+private:
+   void IndexNewPads();
+
+public:
    ClassDefOverride(AtRawEvent, 5);
 };
 
@@ -56,6 +56,16 @@ AtTrack::AtTrack(const AtTrack &o)
    fPattern = (o.fPattern != nullptr) ? o.fPattern->Clone() : nullptr;
 }
 
+/**
+ * @brief Move constructor.
+ *
+ * Declared noexcept so containers of tracks move them instead of copying every hit when they grow.
+ */
+AtTrack::AtTrack(AtTrack &&obj) noexcept : TObject(obj)
+{
+   swap(*this, obj);
+}
+
 void AtTrack::AddClusterHit(std::shared_ptr<AtHitCluster> hitCluster)
 {
    fHitClusterArray.push_back(std::move(*hitCluster));
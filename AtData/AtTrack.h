@@ -44,7 +44,7 @@ public:
    AtTrack() = default;
    AtTrack(const AtTrack &obj);
    AtTrack &operator=(AtTrack obj);
-   AtTrack(AtTrack &&) = default;
+   AtTrack(AtTrack &&obj) noexcept;
    ~AtTrack() = default;
    friend void swap(AtTrack &a, AtTrack &b) noexcept;
 
@@ -59,6 +59,7 @@ public:
    Double_t GetGeoRadius() const { return fGeoRadius; }
    std::pair<Double_t, Double_t> GetGeoCenter() const { return fGeoCenter; }
    std::vector<AtHitCluster> *GetHitClusterArray() { return &fHitClusterArray; }
+   const std::vector<AtHitCluster> &GetHitClusterArrayConst() const { return fHitClusterArray; }
 
    Bool_t GetIsMerged() const { return fIsMerged; }
    Double_t GetVertexToZDist() const { return fVertexToZDist; }
@@ -66,7 +67,7 @@ public:
    // Setters
    void SetTrackID(Int_t val) { fTrackID = val; }
    void AddHit(const AtHit &hit) { fHitArray.push_back(hit); }
-   void AddHit(AtHit &&hit) { fHitArray.push_back(hit); }
+   void AddHit(AtHit &&hit) { fHitArray.push_back(std::move(hit)); }
    void SetPattern(std::unique_ptr<AtPatterns::AtPattern> pat) { fPattern = std::move(pat); }
 
    void SetGeoTheta(Double_t angle) { fGeoThetaAngle = angle; }
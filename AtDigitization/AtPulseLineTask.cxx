@@ -11,8 +11,6 @@
 #include <Math/Vector3Dfwd.h>
 #include <TAxis.h>
 #include <TClonesArray.h>
-#include <TH1.h>
-#include <TH2Poly.h>
 #include <TMath.h>
 #include <TObject.h>
 #include <TRandom.h>
@@ -34,13 +32,13 @@ AtPulseLineTask::AtPulseLineTask() : AtPulseTask("AtPulseLineTask")
 
 AtPulseLineTask::~AtPulseLineTask() = default;
 
-Int_t AtPulseLineTask::throwRandomAndGetBinAfterDiffusion(const ROOT::Math::XYZVector &loc, Double_t diffusionSigma)
+Int_t AtPulseLineTask::throwRandomAndGetPadAfterDiffusion(const ROOT::Math::XYZVector &loc, Double_t diffusionSigma)
 {
    auto r = gRandom->Gaus(0, diffusionSigma);
    auto phi = gRandom->Uniform(0, TMath::TwoPi());
    Double_t propX = loc.x() + r * TMath::Cos(phi);
    Double_t propY = loc.y() + r * TMath::Sin(phi);
-   return fPadPlane->FindBin(propX, propY);
+   return fMap->GetPadNumFromPosition(propX, propY);
 }
 
 void AtPulseLineTask::generateIntegrationMap(AtSimulatedLine &line)
@@ -52,12 +50,11 @@ void AtPulseLineTask::generateIntegrationMap(AtSimulatedLine &line)
 
    LOG(debug2) << "Sampling with transverse diffusion of: " << line.GetTransverseDiffusion();
    for (int i = 0; i < fNumIntegrationPoints; ++i) {
-      auto binNumber = throwRandomAndGetBinAfterDiffusion(loc, line.GetTransverseDiffusion());
+      auto padNumber = throwRandomAndGetPadAfterDiffusion(loc, line.GetTransverseDiffusion());
 
-      if (binNumber < 0)
+      if (padNumber < 0)
          continue;
 
-      auto padNumber = fMap->BinToPad(binNumber);
       fXYintegrationMap[padNumber]++;
       validPoints++;
    }
@@ -84,11 +81,10 @@ bool AtPulseLineTask::gatherElectronsFromSimulatedPoint(AtSimulatedPoint *point)
          continue;
 
       for (int i = 0; i < zIntegration.size(); ++i) {
-         auto zLoc = eleAccumulated[0]->GetXaxis()->GetBinCenter(i + binMin);
+         auto zLoc = fTimeAxis.GetBinCenter(i + binMin);
          auto charge = line->GetCharge() * zIntegration[i] * pad.second;
          auto gAvg = getAvgGETgain(charge);
-         eleAccumulated[pad.first]->Fill(zLoc, gAvg * charge);
-         electronsMap[pad.first] = eleAccumulated[pad.first].get();
+         addElectrons(pad.first, zLoc, gAvg * charge);
       }
 
       if (fIsSaveMCInfo) {
@@ -120,7 +116,7 @@ Int_t AtPulseLineTask::integrateTimebuckets(std::vector<double> &zIntegral, AtSi
    auto tIntegrationMinimum = tMin - fNumSigmaToIntegrateZ * line->GetLongitudinalDiffusion();
    auto tIntegrationMaximum = tMax + fNumSigmaToIntegrateZ * line->GetLongitudinalDiffusion();
 
-   const TAxis *axis = eleAccumulated[0]->GetXaxis();
+   const TAxis *axis = &fTimeAxis;
    auto binMin = axis->FindBin(tIntegrationMinimum);
    auto binMax = axis->FindBin(tIntegrationMaximum);
    if (binMin < fTBPadPlane)
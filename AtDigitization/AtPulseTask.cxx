@@ -18,7 +18,6 @@
 #include <TAxis.h>
 #include <TClonesArray.h>
 #include <TF1.h>
-#include <TH1.h>
 #include <TH2Poly.h>
 #include <TMath.h>
 #include <TObject.h>
@@ -26,7 +25,6 @@
 
 #include <algorithm> // for max
 #include <cmath>
-#include <cstdio>
 #include <iostream>
 #include <utility>
 
@@ -89,13 +87,29 @@ void AtPulseTask::getPadPlaneAndCreatePadHist()
    fMap->GeneratePadPlane();
    fPadPlane = fMap->GetPadPlane();
 
-   char buff[100];
-   eleAccumulated.reserve(fMap->GetNumPads());
-   for (Int_t padS = 0; padS < fMap->GetNumPads(); padS++) {
-      sprintf(buff, "%d", padS);
-      auto maxTime = fTBTime * fNumTbs; // maxTime in ns
-      eleAccumulated.push_back(std::make_unique<TH1F>(buff, buff, fNumTbs, 0, maxTime));
+   auto maxTime = fTBTime * fNumTbs;
+   fTimeAxis.Set(fNumTbs, 0, maxTime);
+}
+
+/**
+ * Tabulate the response function at each time bucket, so the response of a pad is the convolution of its
+ * charge with the kernel. Charge in bucket k contributes fResponseKernel[n - k] to bucket n, which is the
+ * response a time (n - k) * fTBTime after the charge arrived. The kernel is cut after the last value that
+ * is not negligible.
+ */
+void AtPulseTask::fillResponseKernel()
+{
+   fResponseKernel.assign(fNumTbs, 0);
+   double maxResponse = 0;
+   for (Int_t i = 1; i < fNumTbs; ++i) {
+      fResponseKernel[i] = fResponseFunction(i * fTBTime / fPeakingTime);
+      maxResponse = std::max(maxResponse, std::abs(fResponseKernel[i]));
    }
+
+   auto size = fResponseKernel.size();
+   while (size > 1 && std::abs(fResponseKernel[size - 1]) <= 1e-9 * maxResponse)
+      --size;
+   fResponseKernel.resize(size);
 }
 
 InitStatus AtPulseTask::Init()
@@ -113,6 +127,7 @@ InitStatus AtPulseTask::Init()
 
    setParameters();
    getPadPlaneAndCreatePadHist();
+   fillResponseKernel();
    fEventID = 0;
    fRawEvent = nullptr;
 
@@ -149,9 +164,6 @@ void AtPulseTask::saveMCInfo(int mcPointID, int padNumber, int trackID)
 
 void AtPulseTask::reset()
 {
-   for (auto &pad : eleAccumulated)
-      pad->Reset();
-
    electronsMap.clear();
    MCPointsMap.clear();
    fRawEventArray.Delete();
@@ -172,8 +184,7 @@ bool AtPulseTask::gatherElectronsFromSimulatedPoint(AtSimulatedPoint *point)
    eTime += fTBPadPlane * fTBTime;   // correct time for pad plane location
    auto charge = point->GetCharge(); // number of electrons
 
-   auto binNumber = fPadPlane->Fill(xElectron, yElectron);
-   auto padNumber = fMap->BinToPad(binNumber);
+   auto padNumber = fMap->GetPadNumFromPosition(xElectron, yElectron);
    auto mcPoint = dynamic_cast<AtMCPoint *>(fMCPointArray->At(point->GetMCPointID()));
    auto trackID = mcPoint->GetTrackID();
 
@@ -188,13 +199,24 @@ bool AtPulseTask::gatherElectronsFromSimulatedPoint(AtSimulatedPoint *point)
    auto totalyInhibited = fMap->IsInhibited(padNumber) == AtMap::InhibitType::kTotal;
    if (!totalyInhibited) {
       auto gAvg = getAvgGETgain(charge);
-      eleAccumulated[padNumber]->Fill(eTime, charge * gAvg);
-      electronsMap[padNumber] = eleAccumulated[padNumber].get();
+      addElectrons(padNumber, eTime, charge * gAvg);
    }
 
    return true;
 }
 
+/// Add charge to the time bucket of padNum containing time (in us). Charge outside of the time window is dropped.
+void AtPulseTask::addElectrons(Int_t padNum, Double_t time, Double_t charge)
+{
+   auto &trace = electronsMap[padNum];
+   if (trace.empty())
+      trace.assign(fNumTbs, 0);
+
+   auto bin = fTimeAxis.FindFixBin(time);
+   if (bin >= 1 && bin <= fNumTbs)
+      trace[bin - 1] += charge;
+}
+
 void AtPulseTask::Exec(Option_t *option)
 {
    LOG(debug) << "Exec of AtPulseTask";
@@ -226,29 +248,24 @@ double AtPulseTask::nominalResponseFunction(double reducedTime)
 
 void AtPulseTask::generateTracesFromGatheredElectrons()
 {
-   TAxis *axis = eleAccumulated[0]->GetXaxis();
-   Double_t binWidth = axis->GetBinWidth(10);
-
-   std::vector<Int_t> signal(fNumTbs, 0);
-   for (auto &ite2 : electronsMap) {
-      for (Int_t kk = 0; kk < fNumTbs; kk++)
-         signal[kk] = 0;
-      Int_t thePadNumber = (ite2.first);
+   std::vector<Double_t> signal(fNumTbs);
+   for (auto &[thePadNumber, charge] : electronsMap) {
+      std::fill(signal.begin(), signal.end(), 0);
 
+      // Convolve the charge with the response. The inner loop runs over contiguous arrays so it vectorizes.
       for (Int_t kk = 0; kk < fNumTbs; kk++) {
-         if (eleAccumulated[thePadNumber]->GetBinContent(kk) > 0) {
-            for (Int_t nn = kk; nn < fNumTbs; nn++) {
-               Double_t binCenter = axis->GetBinCenter(kk);
-               Double_t factor = (((((Double_t)nn) + 0.5) * binWidth) - binCenter) / fPeakingTime;
-               signal[nn] += eleAccumulated[thePadNumber]->GetBinContent(kk) * fResponseFunction(factor);
-            }
+         if (charge[kk] > 0) {
+            auto nMax = std::min<std::size_t>(fNumTbs - kk, fResponseKernel.size());
+            auto *out = signal.data() + kk;
+            for (std::size_t n = 1; n < nMax; ++n)
+               out[n] += charge[kk] * fResponseKernel[n];
          }
       }
 
       // Create pad
       auto pad = fRawEvent->AddPad(thePadNumber);
 
-      auto PadCenterCoord = fMap->CalcPadCenter(thePadNumber);
+      auto PadCenterCoord = fMap->GetPadCenter(thePadNumber);
       pad->SetValidPad(kTRUE);
       pad->SetPadCoord(PadCenterCoord);
       pad->SetPedestalSubtracted(kTRUE);
@@ -11,9 +11,9 @@
 #include <FairTask.h>
 
 #include <Rtypes.h>
+#include <TAxis.h>
 #include <TClonesArray.h>
 #include <TF1.h> //Needed for unique_ptr<TF1>
-#include <TH1.h> //Needed for unique_ptr<TH1F>
 
 #include <cstddef>
 #include <iterator>
@@ -59,9 +59,10 @@ protected:
 
    AtRawEvent *fRawEvent{}; //!< Raw Event Object
 
-   std::map<Int_t, TH1F *> electronsMap;              //!<
-   std::vector<std::unique_ptr<TH1F>> eleAccumulated; //!<
-   std::multimap<Int_t, std::size_t> MCPointsMap;     //!< [padNum] = mcPointID
+   TAxis fTimeAxis;                                    //!< Time buckets (in us) electrons are accumulated in
+   std::map<Int_t, std::vector<Float_t>> electronsMap; //!< [padNum] = charge in each time bucket
+   std::vector<Double_t> fResponseKernel;              //!< Response to charge in the previous n-th time bucket
+   std::multimap<Int_t, std::size_t> MCPointsMap;      //!< [padNum] = mcPointID
 
    std::unique_ptr<TF1> gain; //!<
    Double_t avgGainDeviation{};
@@ -93,7 +94,9 @@ protected:
    void saveMCInfo(int mcPointID, int padNumber, int trackID);
    void setParameters();
    void getPadPlaneAndCreatePadHist();
+   void fillResponseKernel();
    void reset();
+   void addElectrons(Int_t padNum, Double_t time, Double_t charge);
    void generateTracesFromGatheredElectrons();
    double getAvgGETgain(Int_t numElectrons);
    static double nominalResponseFunction(double reducedTime);
@@ -102,7 +105,7 @@ protected:
    // Returns if any electrons were added
    virtual bool gatherElectronsFromSimulatedPoint(AtSimulatedPoint *point);
 
-   ClassDefOverride(AtPulseTask, 4);
+   ClassDefOverride(AtPulseTask, 5);
 };
 
 template <typename Iterator>
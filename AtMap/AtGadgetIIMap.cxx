@@ -212,6 +212,7 @@ void AtGadgetIIMap::GeneratePadPlane()
 
    // fPadInd = pad_num;
    kIsParsed = true;
+   InvalidateLookupTables();
    for (auto ipad = 0; ipad < pad_num; ++ipad) {
       Double_t px[] = {AtPadCoord[ipad][0][0], AtPadCoord[ipad][1][0], AtPadCoord[ipad][2][0], AtPadCoord[ipad][3][0],
                        AtPadCoord[ipad][0][0]};
@@ -249,7 +250,7 @@ void AtGadgetIIMap::GeneratePadPlane()
    //
 }
 
-XYPoint AtGadgetIIMap::CalcPadCenter(Int_t PadRef)
+XYPoint AtGadgetIIMap::CalcPadCenter(Int_t PadRef) const
 {
 
    if (!kIsParsed) {
@@ -281,6 +282,8 @@ TH2Poly *AtGadgetIIMap::GetPadPlane()
    fPadPlane->SetTitle("GADGETII_Plane");
    fPadPlane->ChangePartition(500, 500);
 
+   BuildPadLocator();
+
    if (kGUIMode)
       drawPadPlane();
 
@@ -26,10 +26,10 @@ public:
    AtGadgetIIMap();
    ~AtGadgetIIMap();
 
-   void Dump() override;                                         // pure virtual member
-   void GeneratePadPlane() override;                             // pure virtual member
-   ROOT::Math::XYPoint CalcPadCenter(Int_t PadRef) override;     // pure virtual member
-   Int_t BinToPad(Int_t binval) override { return binval - 1; }; // pure virtual member
+   void Dump() override;                                           // pure virtual member
+   void GeneratePadPlane() override;                               // pure virtual member
+   ROOT::Math::XYPoint CalcPadCenter(Int_t PadRef) const override; // pure virtual member
+   Int_t BinToPad(Int_t binval) override { return binval - 1; };   // pure virtual member
 
    TH2Poly *GetPadPlane() override; // virtual member
 
@@ -4,8 +4,12 @@
 
 #include <Rtypes.h>
 #include <TCanvas.h>
+#include <TCollection.h>
 #include <TDOMParser.h>
+#include <TGraph.h>
 #include <TH2Poly.h>
+#include <TList.h>
+#include <TMultiGraph.h>
 #include <TStyle.h>
 #include <TXMLDocument.h>
 #include <TXMLNode.h>
@@ -13,6 +17,8 @@
 #include <boost/multi_array/base.hpp>
 #include <boost/multi_array/extent_gen.hpp>
 
+#include <algorithm>
+#include <cmath>
 #include <cstdlib>
 #include <cstring>
 #include <iostream>
@@ -26,6 +32,7 @@ constexpr auto cNORMAL = "\033[0m";
 constexpr auto cGREEN = "\033[1;32m";
 
 using InhibitType = AtMap::InhibitType;
+using XYPoint = ROOT::Math::XYPoint;
 std::ostream &operator<<(std::ostream &os, const AtMap::InhibitType &t)
 {
    switch (t) {
@@ -37,10 +44,183 @@ std::ostream &operator<<(std::ostream &os, const AtMap::InhibitType &t)
    return os;
 }
 
+namespace {
+/// Same test as TMath::IsInside, used by TH2Poly to find the bin containing a point
+bool IsInsidePolygon(Double_t xp, Double_t yp, std::size_t n, const Double_t *x, const Double_t *y)
+{
+   bool oddNodes = false;
+   for (std::size_t i = 0, j = n - 1; i < n; j = i++) {
+      if ((y[i] < yp && y[j] >= yp) || (y[j] < yp && y[i] >= yp)) {
+         if (x[i] + (yp - y[i]) / (y[j] - y[i]) * (x[j] - x[i]) < xp)
+            oddNodes = !oddNodes;
+      }
+   }
+   return oddNodes;
+}
+} // namespace
+
 AtMap::AtMap() : AtPadCoord(boost::extents[10240][3][2]), fPadPlane(new TH2Poly()) {}
 
+void AtMap::BuildPadLocator()
+{
+   PadLocator loc;
+   loc.vertexStart.push_back(0);
+   auto addPolygon = [&loc](Int_t padNum, const TGraph &graph) {
+      if (graph.GetN() < 3)
+         return;
+      loc.padNum.push_back(padNum);
+      loc.x.insert(loc.x.end(), graph.GetX(), graph.GetX() + graph.GetN());
+      loc.y.insert(loc.y.end(), graph.GetY(), graph.GetY() + graph.GetN());
+      loc.vertexStart.push_back(loc.x.size());
+   };
+
+   TIter nextBin(fPadPlane->GetBins());
+   while (auto *bin = dynamic_cast<TH2PolyBin *>(nextBin())) {
+      auto padNum = BinToPad(bin->GetBinNumber());
+      if (auto *graph = dynamic_cast<TGraph *>(bin->GetPolygon()); graph != nullptr)
+         addPolygon(padNum, *graph);
+      else if (auto *multiGraph = dynamic_cast<TMultiGraph *>(bin->GetPolygon()); multiGraph != nullptr) {
+         TIter nextGraph(multiGraph->GetListOfGraphs());
+         while (auto *part = dynamic_cast<TGraph *>(nextGraph()))
+            addPolygon(padNum, *part);
+      }
+   }
+
+   auto numPolygons = loc.padNum.size();
+   if (numPolygons == 0) {
+      fPadLocator = std::move(loc);
+      return;
+   }
+
+   loc.min = {*std::min_element(loc.x.begin(), loc.x.end()), *std::min_element(loc.y.begin(), loc.y.end())};
+   loc.max = {*std::max_element(loc.x.begin(), loc.x.end()), *std::max_element(loc.y.begin(), loc.y.end())};
+   // About four cells per pad
+   auto cellsPerSide = std::clamp(static_cast<Int_t>(2 * std::sqrt(numPolygons)), 1, 1000);
+   for (int i = 0; i < 2; ++i) {
+      loc.numCells[i] = cellsPerSide;
+      loc.cellSize[i] = loc.max[i] > loc.min[i] ? (loc.max[i] - loc.min[i]) / cellsPerSide : 1;
+   }
+   auto toCell = [&loc](int axis, Double_t val) {
+      auto cell = static_cast<Int_t>((val - loc.min[axis]) / loc.cellSize[axis]);
+      return std::clamp(cell, 0, loc.numCells[axis] - 1);
+   };
+
+   // Call func(cell) for each cell overlapping the bounding box of the polygon
+   auto forEachCell = [&loc, &toCell](std::size_t poly, auto func) {
+      auto first = loc.vertexStart[poly];
+      auto last = loc.vertexStart[poly + 1];
+      auto [xMin, xMax] = std::minmax_element(loc.x.begin() + first, loc.x.begin() + last);
+      auto [yMin, yMax] = std::minmax_element(loc.y.begin() + first, loc.y.begin() + last);
+      for (auto iy = toCell(1, *yMin); iy <= toCell(1, *yMax); ++iy)
+         for (auto ix = toCell(0, *xMin); ix <= toCell(0, *xMax); ++ix)
+            func(iy * loc.numCells[0] + ix);
+   };
+
+   loc.cellStart.assign(loc.numCells[0] * loc.numCells[1] + 1, 0);
+   for (std::size_t poly = 0; poly < numPolygons; ++poly)
+      forEachCell(poly, [&loc](Int_t cell) { ++loc.cellStart[cell + 1]; });
+   for (std::size_t cell = 1; cell < loc.cellStart.size(); ++cell)
+      loc.cellStart[cell] += loc.cellStart[cell - 1];
+
+   loc.cellPolygons.resize(loc.cellStart.back());
+   auto fill = loc.cellStart;
+   for (std::size_t poly = 0; poly < numPolygons; ++poly)
+      forEachCell(poly, [&loc, &fill, poly](Int_t cell) { loc.cellPolygons[fill[cell]++] = poly; });
+
+   fPadLocator = std::move(loc);
+}
+
+Int_t AtMap::GetPadNumFromPosition(Double_t x, Double_t y) const
+{
+   const auto &loc = fPadLocator;
+   if (loc.padNum.empty() || x < loc.min[0] || x > loc.max[0] || y < loc.min[1] || y > loc.max[1])
+      return -1;
+
+   auto ix = std::min(static_cast<Int_t>((x - loc.min[0]) / loc.cellSize[0]), loc.numCells[0] - 1);
+   auto iy = std::min(static_cast<Int_t>((y - loc.min[1]) / loc.cellSize[1]), loc.numCells[1] - 1);
+   auto cell = iy * loc.numCells[0] + ix;
+   for (auto i = loc.cellStart[cell]; i < loc.cellStart[cell + 1]; ++i) {
+      auto poly = loc.cellPolygons[i];
+      auto begin = loc.vertexStart[poly];
+      if (IsInsidePolygon(x, y, loc.vertexStart[poly + 1] - begin, &loc.x[begin], &loc.y[begin]))
+         return loc.padNum[poly];
+   }
+   return -1;
+}
+
+Int_t AtMap::GetTableIndex(const AtPadReference &ref) const
+{
+   if (ref.cobo < 0 || ref.asad < 0 || ref.aget < 0 || ref.ch < 0 || ref.cobo >= fRefExtent[0] ||
+       ref.asad >= fRefExtent[1] || ref.aget >= fRefExtent[2] || ref.ch >= fRefExtent[3])
+      return -1;
+   return ((ref.cobo * fRefExtent[1] + ref.asad) * fRefExtent[2] + ref.aget) * fRefExtent[3] + ref.ch;
+}
+
+void AtMap::BuildLookupTables() const
+{
+   std::lock_guard<std::mutex> lock(fTablesMutex);
+   if (fTablesBuilt.load(std::memory_order_relaxed))
+      return;
+
+   // Channels or pads outside of the tables fall back to the maps, so only valid entries are included
+   fRefExtent.fill(0);
+   auto growExtent = [this](const AtPadReference &ref) {
+      if (ref.cobo < 0 || ref.asad < 0 || ref.aget < 0 || ref.ch < 0)
+         return;
+      fRefExtent[0] = std::max(fRefExtent[0], ref.cobo + 1);
+      fRefExtent[1] = std::max(fRefExtent[1], ref.asad + 1);
+      fRefExtent[2] = std::max(fRefExtent[2], ref.aget + 1);
+      fRefExtent[3] = std::max(fRefExtent[3], ref.ch + 1);
+   };
+   for (const auto &[ref, padNum] : fPadMap)
+      growExtent(ref);
+   for (const auto &[ref, name] : fAuxPadMap)
+      growExtent(ref);
+
+   auto numChannels = fRefExtent[0] * fRefExtent[1] * fRefExtent[2] * fRefExtent[3];
+   fPadNumTable.assign(numChannels, -1);
+   fAuxTable.assign(numChannels, false);
+   for (const auto &[ref, padNum] : fPadMap)
+      if (auto idx = GetTableIndex(ref); idx >= 0)
+         fPadNumTable[idx] = padNum;
+   for (const auto &[ref, name] : fAuxPadMap)
+      if (auto idx = GetTableIndex(ref); idx >= 0)
+         fAuxTable[idx] = true;
+
+   Int_t numPads = fNumberPads;
+   if (!fPadMapInverse.empty())
+      numPads = std::max(numPads, fPadMapInverse.rbegin()->first + 1);
+   if (!fPadSizeMap.empty())
+      numPads = std::max(numPads, fPadSizeMap.rbegin()->first + 1);
+   if (!fIniPads.empty())
+      numPads = std::max(numPads, fIniPads.rbegin()->first + 1);
+
+   fInhibitTable.assign(numPads, InhibitType::kNone);
+   for (const auto &[padNum, type] : fIniPads)
+      if (padNum >= 0)
+         fInhibitTable[padNum] = type;
+
+   fPadSizeTable.assign(numPads, -1000);
+   for (const auto &[padNum, size] : fPadSizeMap)
+      if (padNum >= 0)
+         fPadSizeTable[padNum] = size;
+
+   // Until the map has what it needs CalcPadCenter only reports an error, so leave it to be called directly
+   fPadCenterTable.clear();
+   if (CanCalcPadCenters()) {
+      fPadCenterTable.resize(std::min<Int_t>(numPads, AtPadCoord.shape()[0]));
+      for (Int_t padNum = 0; padNum < static_cast<Int_t>(fPadCenterTable.size()); ++padNum)
+         fPadCenterTable[padNum] = CalcPadCenter(padNum);
+   }
+
+   fTablesBuilt.store(true, std::memory_order_release);
+}
+
 Int_t AtMap::GetPadNum(const AtPadReference &PadRef) const
 {
+   EnsureLookupTables();
+   if (auto idx = GetTableIndex(PadRef); idx >= 0 && (fPadNumTable[idx] != -1 || !kDebug))
+      return fPadNumTable[idx];
 
    // Option 1: Int key - vector<int> value
    // std::map<int, std::vector<int>>::const_iterator ite = fPadMap.find(1);
@@ -81,6 +261,7 @@ Bool_t AtMap::ParseInhibitMap(TString inimap, AtMap::InhibitType type)
       fIni >> pad;
       inhibitPad(pad, type);
    }
+   InvalidateLookupTables();
 
    LOG(info) << cYELLOW << fIniPads.size() << " pads in inhibition list." << cNORMAL;
    return true;
@@ -91,9 +272,14 @@ void AtMap::inhibitPad(Int_t padNum, AtMap::InhibitType type)
    auto pad = fIniPads.find(padNum);
    if (pad == fIniPads.end() || pad->second < type)
       fIniPads[padNum] = type;
+   InvalidateLookupTables();
 }
-AtMap::InhibitType AtMap::IsInhibited(Int_t PadNum)
+AtMap::InhibitType AtMap::IsInhibited(Int_t PadNum) const
 {
+   EnsureLookupTables();
+   if (PadNum >= 0 && PadNum < static_cast<Int_t>(fInhibitTable.size()))
+      return fInhibitTable[PadNum];
+
    auto pad = fIniPads.find(PadNum);
    if (pad == fIniPads.end())
       return InhibitType::kNone;
@@ -101,11 +287,24 @@ AtMap::InhibitType AtMap::IsInhibited(Int_t PadNum)
       return pad->second;
 }
 
-int AtMap::GetPadSize(int padNum)
+int AtMap::GetPadSize(int padNum) const
 {
-   if (fPadSizeMap.find(padNum) == fPadSizeMap.end())
+   EnsureLookupTables();
+   if (padNum >= 0 && padNum < static_cast<int>(fPadSizeTable.size()))
+      return fPadSizeTable[padNum];
+
+   auto size = fPadSizeMap.find(padNum);
+   if (size == fPadSizeMap.end())
       return -1000;
-   return fPadSizeMap[padNum];
+   return size->second;
+}
+
+XYPoint AtMap::GetPadCenter(Int_t padNum) const
+{
+   EnsureLookupTables();
+   if (padNum >= 0 && padNum < static_cast<Int_t>(fPadCenterTable.size()))
+      return fPadCenterTable[padNum];
+   return CalcPadCenter(padNum);
 }
 void AtMap::ParseAtTPCMap(TXMLNode *node)
 {
@@ -138,6 +337,7 @@ void AtMap::ParseAtTPCMap(TXMLNode *node)
    fPadMap.insert(std::pair<AtPadReference, int>(ref, fPadID));
    fPadMapInverse.insert(std::pair<int, AtPadReference>(fPadID, ref));
    fPadSizeMap.insert(std::pair<int, int>(fPadID, fSizeID));
+   InvalidateLookupTables();
 }
 
 void AtMap::ParseMapList(TXMLNode *node)
@@ -213,6 +413,7 @@ Bool_t AtMap::DumpAtTPCMap()
 bool AtMap::AddAuxPad(const AtPadReference &ref, std::string auxName)
 {
    auto emplacePair = fAuxPadMap.emplace(ref, auxName);
+   InvalidateLookupTables();
    std::cout << cGREEN << " Auxiliary channel added " << fAuxPadMap[ref] << " - Hash "
              << std::hash<AtPadReference>()(ref) << cNORMAL << "\n";
 
@@ -220,6 +421,9 @@ bool AtMap::AddAuxPad(const AtPadReference &ref, std::string auxName)
 }
 bool AtMap::IsAuxPad(const AtPadReference &ref) const
 {
+   EnsureLookupTables();
+   if (auto idx = GetTableIndex(ref); idx >= 0)
+      return fAuxTable[idx];
    return fAuxPadMap.find(ref) != fAuxPadMap.end();
 }
 std::string AtMap::GetAuxName(const AtPadReference &ref) const
@@ -11,18 +11,23 @@
 
 #include "AtPadReference.h"
 
-#include <Math/Point2Dfwd.h>
+#include <Math/Point2D.h>
 #include <Rtypes.h>
 #include <TNamed.h>
 #include <TString.h>
 
 #include <boost/multi_array.hpp>
 
+#include <array>
+#include <atomic>
+#include <cstddef>
 #include <functional>
 #include <iosfwd>
 #include <map>
+#include <mutex>
 #include <string>
 #include <unordered_map>
+#include <vector>
 
 class TH2Poly;
 class TXMLNode;
@@ -54,21 +59,76 @@ protected:
    std::unordered_map<AtPadReference, std::string> fAuxPadMap;
    std::map<int, int> fPadSizeMap;
 
+   // Flat copies of the maps above, indexed by electronics channel or pad number. Built the first time
+   // they are needed and rebuilt after the map changes.
+   mutable std::atomic<bool> fTablesBuilt{false};            //!
+   mutable std::mutex fTablesMutex;                          //!
+   mutable std::array<Int_t, 4> fRefExtent{};                //! Number of cobo, asad, aget and channels in the tables
+   mutable std::vector<Int_t> fPadNumTable;                  //! Pad number of each channel (-1 if not mapped)
+   mutable std::vector<Bool_t> fAuxTable;                    //! If each channel is an auxiliary channel
+   mutable std::vector<AtMap::InhibitType> fInhibitTable;    //! Inhibit type of each pad number
+   mutable std::vector<Int_t> fPadSizeTable;                 //! Size ID of each pad number
+   mutable std::vector<ROOT::Math::XYPoint> fPadCenterTable; //! Center of each pad number
+
    void inhibitPad(Int_t padNum, AtMap::InhibitType type);
    void drawPadPlane();
 
+   /// Must be called whenever the mapping, inhibited pads or pad geometry change
+   void InvalidateLookupTables() { fTablesBuilt = false; }
+   /// If CalcPadCenter can be called for every pad without errors, so the table of pad centers can be filled
+   virtual Bool_t CanCalcPadCenters() const { return kIsParsed; }
+
+   /**
+    * Build the locator used by GetPadNumFromPosition from the bins of fPadPlane. Must be called after the bins
+    * of the pad plane are added.
+    */
+   void BuildPadLocator();
+
+private:
+   /// Uniform grid over the pad plane, where each cell lists the pad polygons overlapping it
+   struct PadLocator {
+      std::vector<Int_t> padNum;              // Pad number of each polygon
+      std::vector<std::size_t> vertexStart;   // First vertex of each polygon, and one past the last vertex
+      std::vector<Double_t> x, y;             // Vertices of all polygons
+      std::array<Double_t, 2> min{}, max{};   // Corners of the grid
+      std::array<Double_t, 2> cellSize{};     // Size of each cell in x and y
+      std::array<Int_t, 2> numCells{};        // Number of cells in x and y
+      std::vector<std::size_t> cellStart;     // First entry of each cell in cellPolygons, and one past the last
+      std::vector<Int_t> cellPolygons;        // Polygons overlapping each cell, in the order of the bins
+   };
+   PadLocator fPadLocator; //!
+
+   void BuildLookupTables() const;
+   void EnsureLookupTables() const
+   {
+      if (!fTablesBuilt.load(std::memory_order_acquire))
+         BuildLookupTables();
+   }
+   Int_t GetTableIndex(const AtPadReference &ref) const;
+
 public:
    AtMap();
    ~AtMap() = default;
 
    virtual void Dump() = 0;
    virtual void GeneratePadPlane() = 0;
-   virtual ROOT::Math::XYPoint CalcPadCenter(Int_t PadRef) = 0; // units mm
+   virtual ROOT::Math::XYPoint CalcPadCenter(Int_t PadRef) const = 0; // units mm
    virtual TH2Poly *GetPadPlane() = 0;
    virtual Int_t BinToPad(Int_t binval) = 0;
 
+   /// Same as CalcPadCenter, but looked up in a table of pad centers
+   ROOT::Math::XYPoint GetPadCenter(Int_t padNum) const;
+
    UInt_t GetNumPads() const { return fNumberPads; }
 
+   /**
+    * @brief Pad number at a position (in mm) on the pad plane, or -1 if there is no pad there.
+    *
+    * Gives the same pad as filling the pad plane and calling BinToPad, but does not change the pad plane, so
+    * it can be called from several threads. Valid once GetPadPlane has been called.
+    */
+   Int_t GetPadNumFromPosition(Double_t x, Double_t y) const;
+
    Int_t GetPadNum(const AtPadReference &PadRef) const;
    multiarray GetPadCoordArr() { return AtPadCoord; }
    multiarray *GetPadCoord() { return fAtPadCoordPtr = &AtPadCoord; }
@@ -85,8 +145,8 @@ public:
    inline void SetGUIMode() { kGUIMode = 1; }
    inline void SetDebugMode(Bool_t flag = true) { kDebug = flag; }
    Bool_t ParseInhibitMap(TString inimap, AtMap::InhibitType type);
-   AtMap::InhibitType IsInhibited(Int_t PadNum);
-   Int_t GetPadSize(int padNum);
+   AtMap::InhibitType IsInhibited(Int_t PadNum) const;
+   Int_t GetPadSize(int padNum) const;
 
    // The higher the number, the higher the priority
    // i.e. Adding a pad to the inhibit map with kTotal and kLowGain
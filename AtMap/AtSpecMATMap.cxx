@@ -179,6 +179,8 @@ TH2Poly *AtSpecMATMap::GetPadPlane()
       fPadPlane->AddBin(3, x, y);
    }
 
+   BuildPadLocator();
+
    if (kGUIMode)
       drawPadPlane();
 
@@ -265,9 +267,10 @@ void AtSpecMATMap::GeneratePadPlane()
 
    std::cout << " A total of  " << fNumberPads << " pads were generated  " << std::endl;
    kIsParsed = true;
+   InvalidateLookupTables();
 }
 
-XYPoint AtSpecMATMap::CalcPadCenter(Int_t PadRef)
+XYPoint AtSpecMATMap::CalcPadCenter(Int_t PadRef) const
 {
    if (!kIsParsed) {
       LOG(error) << " AtSpecMATMap::CalcPadCenter Error : Pad plane has not been generated or parsed";
@@ -24,10 +24,10 @@ public:
    AtSpecMATMap(Int_t fNumPads = 3174);
    ~AtSpecMATMap();
 
-   void Dump() override;                                         // pure virtual member
-   void GeneratePadPlane() override;                             // pure virtual member
-   ROOT::Math::XYPoint CalcPadCenter(Int_t PadRef) override;     // pure virtual member
-   Int_t BinToPad(Int_t binval) override { return binval - 1; }; // pure virtual member
+   void Dump() override;                                           // pure virtual member
+   void GeneratePadPlane() override;                               // pure virtual member
+   ROOT::Math::XYPoint CalcPadCenter(Int_t PadRef) const override; // pure virtual member
+   Int_t BinToPad(Int_t binval) override { return binval - 1; };   // pure virtual member
 
    TH2Poly *GetPadPlane() override; // virtual member
 
@@ -195,6 +195,7 @@ void AtTpcMap::GeneratePadPlane()
    // fPadInd = pad_index + pad_index_aux;
    std::cout << "created pads: " << pad_index + pad_index_aux << std::endl;
    kIsParsed = true;
+   InvalidateLookupTables();
 }
 
 Int_t AtTpcMap::fill_coord(int pindex, float padxoff, float padyoff, float triside, float fort)
@@ -231,13 +232,15 @@ TH2Poly *AtTpcMap::GetPadPlane()
 
    fPadPlane->ChangePartition(500, 500);
 
+   BuildPadLocator();
+
    if (kGUIMode)
       drawPadPlane();
 
    return fPadPlane;
 }
 
-XYPoint AtTpcMap::CalcPadCenter(Int_t PadRef)
+XYPoint AtTpcMap::CalcPadCenter(Int_t PadRef) const
 {
    if (!kIsParsed) {
       LOG(error) << " AtTpcMap::CalcPadCenter Error : Pad plane has not been generated or parsed ";
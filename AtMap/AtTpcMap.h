@@ -25,7 +25,7 @@ public:
 
    virtual void Dump() override;
    virtual void GeneratePadPlane() override;
-   virtual ROOT::Math::XYPoint CalcPadCenter(Int_t PadRef) override;
+   virtual ROOT::Math::XYPoint CalcPadCenter(Int_t PadRef) const override;
    virtual TH2Poly *GetPadPlane() override;
    virtual Int_t BinToPad(Int_t binval) override { return binval - 1; };
 
@@ -95,6 +95,10 @@ TH2Poly *AtTpcProtoMap::GetPadPlane()
       return nullptr;
    }
 
+   // The pad of each bin is only known once the prototype map is set
+   if (kIsProtoMapSet)
+      BuildPadLocator();
+
    if (kGUIMode)
       drawPadPlane();
 
@@ -114,7 +118,7 @@ TH2Poly *AtTpcProtoMap::GetAtTpcPlane(TString TH2Poly_name)
    return fPadPlane;
 }
 
-XYPoint AtTpcProtoMap::CalcPadCenter(Int_t PadRef)
+XYPoint AtTpcProtoMap::CalcPadCenter(Int_t PadRef) const
 {
 
    if (!kIsProtoMapSet) {
@@ -152,6 +156,11 @@ XYPoint AtTpcProtoMap::CalcPadCenter(Int_t PadRef)
    }
 }
 
+Bool_t AtTpcProtoMap::CanCalcPadCenters() const
+{
+   return kIsParsed && kIsProtoMapSet && f != nullptr && !f->IsZombie();
+}
+
 Bool_t AtTpcProtoMap::SetProtoMap(TString file)
 {
 
@@ -186,6 +195,11 @@ Bool_t AtTpcProtoMap::SetProtoMap(TString file)
       ProtoBinMap.insert(std::pair<Int_t, Int_t>(bin_num, PadNum));
       PadCoord.clear();
    }
+   InvalidateLookupTables();
+
+   // The pad of each bin is only known now, so build the locator if the pad plane already exists
+   if (kIsGenerated)
+      BuildPadLocator();
 
    return kTRUE;
 }
@@ -200,13 +214,13 @@ Int_t AtTpcProtoMap::BinToPad(Int_t binval)
    }
 
    auto its = ProtoBinMap.find(binval);
-   Int_t padval = (*its).second;
-   Int_t kIs = int(ProtoBinMap.find(binval) == ProtoBinMap.end());
-   if (kIs) {
+   if (its == ProtoBinMap.end()) {
       if (kDebug)
          std::cerr << " = AtTpcProtoMap::BinToPad - Bin not found : " << binval << std::endl;
       return -1;
-   } else if (binval > 2014 || binval < 0) {
+   }
+   Int_t padval = (*its).second;
+   if (binval > 2014 || binval < 0) {
 
       std::cout
          << " = AtTpcProtoMap::BinToPad - Warning: Bin value out of expected boundaries for prototype bin mapping : "
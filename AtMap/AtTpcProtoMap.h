@@ -35,13 +35,15 @@ protected:
    std::map<Int_t, std::vector<Float_t>> ProtoGeoMap;
    std::map<Int_t, Int_t> ProtoBinMap;
 
+   virtual Bool_t CanCalcPadCenters() const override;
+
 public:
    AtTpcProtoMap();
    ~AtTpcProtoMap() = default;
 
    virtual void GeneratePadPlane() override;
    virtual void Dump() override;
-   virtual ROOT::Math::XYPoint CalcPadCenter(Int_t PadRef) override;
+   virtual ROOT::Math::XYPoint CalcPadCenter(Int_t PadRef) const override;
    virtual TH2Poly *GetPadPlane() override;
    virtual Int_t BinToPad(Int_t binval) override;
    TH2Poly *GetAtTpcPlane(TString TH2Poly_name);
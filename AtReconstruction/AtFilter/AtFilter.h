@@ -2,6 +2,8 @@
 #define ATFILTER_H
 // Interface for filters that can be applied to the raw signal traces
 
+#include <memory>
+
 class TClonesArray;
 class AtRawEvent;
 class AtPad;
@@ -9,6 +11,11 @@ class AtPad;
 class AtFilter {
 
 public:
+   virtual ~AtFilter() = default;
+
+   // Create a copy of this filter with the same configuration. The clone has not been initialized.
+   virtual std::unique_ptr<AtFilter> Clone() = 0;
+
    // Called at the init stage of the AtFilterTask
    virtual void Init() = 0;
 
@@ -32,6 +32,8 @@ public:
    TString GetCalibrationFile() { return fCalibrationFile; }
    void SetCalibrationFile(TString fileName) { fCalibrationFile = fileName; }
 
+   virtual std::unique_ptr<AtFilter> Clone() override { return std::make_unique<AtFilterCalibrate>(*this); }
+
    virtual void Init() override;
    virtual void InitEvent(AtRawEvent *event) override {}
    virtual void Filter(AtPad *pad) override;
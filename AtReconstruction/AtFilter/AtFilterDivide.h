@@ -5,6 +5,8 @@
 // Example filter to divide the signal by some amount specified at run time
 #include "AtFilter.h"
 
+#include <memory>
+
 class AtPad;
 class AtRawEvent;
 
@@ -17,6 +19,8 @@ public:
    void SetDivisor(Double_t divisor);
    Double_t GetDivisor() { return fDivisor; }
 
+   virtual std::unique_ptr<AtFilter> Clone() override { return std::make_unique<AtFilterDivide>(*this); }
+
    virtual void Init() override;
    virtual void InitEvent(AtRawEvent *event) override;
    virtual void Filter(AtPad *pad) override;
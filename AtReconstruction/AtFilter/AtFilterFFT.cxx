@@ -10,8 +10,15 @@
 #include <TVirtualFFT.h>
 
 #include <iostream>
+#include <stdexcept>
 #include <utility>
 
+AtFilterFFT::AtFilterFFT(const AtFilterFFT &other)
+   : fFreqRanges(other.fFreqRanges), fFactors(other.fFactors), fSaveTransform(other.fSaveTransform),
+     fSubtractBackground(other.fSubtractBackground)
+{
+}
+
 bool AtFilterFFT::AddFreqRange(AtFreqRange range)
 {
    auto canAdd = isValidFreqRange(range);
@@ -28,6 +35,16 @@ void AtFilterFFT::Init()
 {
    std::vector<Int_t> dimSize = {fTransformSize};
 
+   // Look up the factors by index instead of searching the map for every bin of every pad
+   fFactorArray.assign(fTransformSize / 2 + 1, 1);
+   for (const auto &[freq, factor] : fFactors)
+      if (freq >= 0 && freq < fFactorArray.size())
+         fFactorArray[freq] = factor;
+
+   fRe.resize(fTransformSize / 2 + 1);
+   fIm.resize(fTransformSize / 2 + 1);
+   fTrace.resize(fTransformSize);
+
    // Create a FFT object that we own ("K"), that will optimize the transform ("M"),
    // and is a forward transform from real data to complex ("R2C")
    fFFT = std::unique_ptr<TVirtualFFT>(TVirtualFFT::FFT(1, dimSize.data(), "R2C M K"));
@@ -42,6 +59,11 @@ void AtFilterFFT::InitEvent(AtRawEvent *inputEvent)
    if (fSaveTransform) {
       replacePadWithPadFFT(inputEvent);
       fTransformedEvent = inputEvent;
+
+      // Filter() looks up the input pads here so it never modifies the event (it can run on many threads)
+      fTransformedPads.clear();
+      for (auto &pad : inputEvent->fPadList)
+         fTransformedPads.emplace(pad->GetPadNum(), dynamic_cast<AtPadFFT *>(pad.get()));
    }
 }
 
@@ -58,18 +80,21 @@ void AtFilterFFT::Filter(AtPad *pad)
    applyFrequencyCutsAndSetInverseFFT();
    fFFTbackward->Transform();
 
+   fFFTbackward->GetPoints(fTrace.data());
+
    double baseline = 0;
    if (fSubtractBackground) {
       for (int i = 0; i < 20; ++i)
-         baseline += fFFTbackward->GetPointReal(i);
+         baseline += fTrace[i];
       baseline /= 20;
    }
 
-   for (int i = 0; i < pad->GetADC().size(); ++i)
-      pad->SetADC(i, fFFTbackward->GetPointReal(i) - baseline);
+   auto &adc = pad->GetADCBuffer();
+   for (int i = 0; i < adc.size(); ++i)
+      adc[i] = fTrace[i] - baseline;
 
    if (fSaveTransform) {
-      auto inputPad = dynamic_cast<AtPadFFT *>(fTransformedEvent->GetPad(pad->GetPadNum()));
+      auto inputPad = fTransformedPads.at(pad->GetPadNum());
       inputPad->GetDataFromFFT(fFFT.get());
       auto outputPad = dynamic_cast<AtPadFFT *>(pad);
       outputPad->GetDataFromFFT(fFFTbackward.get());
@@ -109,17 +134,21 @@ bool AtFilterFFT::doesFreqRangeOverlap(const AtFreqRange &newRange)
    return false;
 }
 
+/**
+ * Copy the transform out in one call, scale every bin of the non-redundant half of the (hermitian)
+ * spectrum, and copy it into the inverse transform. The other half is implied for a complex to real transform.
+ */
 void AtFilterFFT::applyFrequencyCutsAndSetInverseFFT()
 {
-   for (int i = 0; i < fFFT->GetN()[0]; ++i) {
-      Double_t re, im;
-      fFFT->GetPointComplex(i, re, im);
-      if (fFactors.find(i) != fFactors.end()) {
-         re *= fFactors[i];
-         im *= fFactors[i];
-      }
-      fFFTbackward->SetPoint(i, re / fFFT->GetN()[0], im / fFFT->GetN()[0]);
+   fFFT->GetPointsComplex(fRe.data(), fIm.data());
+
+   const Double_t norm = 1. / fTransformSize;
+   for (int i = 0; i < fFactorArray.size(); ++i) {
+      fRe[i] *= fFactorArray[i] * norm;
+      fIm[i] *= fFactorArray[i] * norm;
    }
+
+   fFFTbackward->SetPointsComplex(fRe.data(), fIm.data());
 }
 
 bool operator<(const AtFilterFFT::AtFreqRange &lhs, const AtFilterFFT::AtFreqRange &rhs)
@@ -135,6 +164,8 @@ void AtFilterFFT::DumpFactors()
 
 void AtFilterFFT::replacePadWithPadFFT(AtRawEvent *event)
 {
+   // Pads may already be replaced if several clones of this filter share the input event
    for (auto &pad : event->fPadList)
-      pad = std::make_unique<AtPadFFT>(*pad);
+      if (dynamic_cast<AtPadFFT *>(pad.get()) == nullptr)
+         pad = std::make_unique<AtPadFFT>(*pad);
 }
@@ -22,9 +22,11 @@
 
 #include <map>
 #include <memory>
+#include <unordered_map>
 #include <vector>
 
 class AtPad;
+class AtPadFFT;
 class AtRawEvent;
 
 class AtFilterFFT : public AtFilter {
@@ -44,19 +46,27 @@ public:
 protected:
    FreqRanges fFreqRanges;
    std::map<Int_t, Double_t> fFactors;
+   std::vector<Double_t> fFactorArray; // Dense copy of fFactors for every frequency bin (built in Init())
 
    std::unique_ptr<TVirtualFFT> fFFT{nullptr};
    std::unique_ptr<TVirtualFFT> fFFTbackward{nullptr};
 
+   // Buffers for moving data in and out of the transforms
+   std::vector<Double_t> fRe;
+   std::vector<Double_t> fIm;
+   std::vector<Double_t> fTrace;
+
    Bool_t fSaveTransform{false};
    Bool_t fSubtractBackground{true};
 
    AtRawEvent *fTransformedEvent{nullptr};
+   std::unordered_map<Int_t, AtPadFFT *> fTransformedPads; // Pads in fTransformedEvent by pad number
    AtRawEvent *fFilteredEvent{nullptr};
    static constexpr Int_t fTransformSize = 512;
 
 public:
    AtFilterFFT() = default;
+   AtFilterFFT(const AtFilterFFT &other); // Copies the frequency cuts, Init() must be called on the copy
    ~AtFilterFFT() = default;
 
    bool AddFreqRange(AtFreqRange range); // Range is inclusive
@@ -69,6 +79,7 @@ public:
    const FreqRanges &GetFreqRanges() { return fFreqRanges; }
    void DumpFactors();
 
+   std::unique_ptr<AtFilter> Clone() override { return std::make_unique<AtFilterFFT>(*this); }
    void Init() override;
    void InitEvent(AtRawEvent *event = nullptr) override;
    void Filter(AtPad *pad) override;
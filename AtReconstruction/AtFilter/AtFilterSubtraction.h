@@ -53,6 +53,8 @@ public:
    void SetIsGood(Bool_t val) { fSetIsGood = val; }
    Double_t GetThreshold() const { return fThreshold; }
 
+   virtual std::unique_ptr<AtFilter> Clone() override { return std::make_unique<AtFilterSubtraction>(*this); }
+
    // Called at the init stage of the AtFilterTask
    virtual void Init() override;
 
@@ -5,6 +5,7 @@
 
 #include <Rtypes.h>
 
+#include <memory>
 #include <vector>
 
 class AtPad;
@@ -40,6 +41,8 @@ public:
    Int_t GetRiseTime() { return fRiseTime; }
    Int_t GetTopTime() { return fTopTime; }
 
+   virtual std::unique_ptr<AtFilter> Clone() override { return std::make_unique<AtTrapezoidFilter>(*this); }
+
    virtual void Init() override {}
    virtual void InitEvent(AtRawEvent *event) override {}
    virtual void Filter(AtPad *pad) override;
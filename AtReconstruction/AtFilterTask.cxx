@@ -10,10 +10,13 @@
 
 #include <TClonesArray.h>
 #include <TObject.h>
+#include <TROOT.h>
 
+#include <algorithm>
 #include <iostream>
 #include <map>
 #include <memory>
+#include <thread>
 #include <utility>
 #include <vector>
 
@@ -45,6 +48,14 @@ InitStatus AtFilterTask::Init()
 
    fFilter->Init();
 
+   fThreadFilters.clear();
+   for (int i = 1; i < fNumThreads; ++i) {
+      fThreadFilters.push_back(fFilter->Clone());
+      fThreadFilters.back()->Init();
+   }
+   if (fNumThreads > 1)
+      ROOT::EnableThreadSafety();
+
    return kSUCCESS;
 }
 
@@ -58,6 +69,8 @@ void AtFilterTask::Exec(Option_t *opt)
    auto rawEvent = dynamic_cast<AtRawEvent *>(fInputEventArray->At(0));
    fFilter->InitEvent(rawEvent); // Can modify rawEvent if necessary (shouldn't touch traces)
    auto filteredEvent = fFilter->ConstructOutputEvent(fOutputEventArray, rawEvent);
+   for (auto &filter : fThreadFilters)
+      filter->InitEvent(rawEvent);
 
    if (!rawEvent->IsGood())
       return;
@@ -68,10 +81,29 @@ void AtFilterTask::Exec(Option_t *opt)
          fFilter->Filter(pad);
       }
 
-   // This is destroying data in next pad in the array
-   for (auto &pad : filteredEvent->fPadList)
-      fFilter->Filter(pad.get());
+   // Give each thread a contiguous block of pads
+   auto numPads = filteredEvent->fPadList.size();
+   auto numThreads = fThreadFilters.size() + 1;
+   auto padsPerThread = (numPads + numThreads - 1) / numThreads;
+
+   std::vector<std::thread> threads;
+   for (std::size_t i = 0; i < fThreadFilters.size(); ++i) {
+      auto begin = std::min(numPads, (i + 1) * padsPerThread);
+      auto end = std::min(numPads, (i + 2) * padsPerThread);
+      threads.emplace_back(&AtFilterTask::FilterPads, this, fThreadFilters[i].get(), filteredEvent, begin, end);
+   }
+   FilterPads(fFilter, filteredEvent, 0, std::min(numPads, padsPerThread));
+   for (auto &thread : threads)
+      thread.join();
 
    auto isGood = filteredEvent->IsGood() && fFilter->IsGoodEvent();
+   for (auto &filter : fThreadFilters)
+      isGood &= filter->IsGoodEvent();
    filteredEvent->SetIsGood(isGood);
 }
+
+void AtFilterTask::FilterPads(AtFilter *filter, AtRawEvent *event, std::size_t begin, std::size_t end)
+{
+   for (auto i = begin; i < end; ++i)
+      filter->Filter(event->fPadList[i].get());
+}
@@ -7,8 +7,12 @@
 
 #include <Rtypes.h>
 
+#include <memory>
+#include <vector>
+
 // ATTPCROOT classes;
 class AtFilter;
+class AtRawEvent;
 // ROOT classes
 class TClonesArray;
 
@@ -22,6 +26,9 @@ private:
    Bool_t fIsPersistent{false};
    Bool_t fFilterAux{false};
 
+   Int_t fNumThreads{1};
+   std::vector<std::unique_ptr<AtFilter>> fThreadFilters; // Clones of fFilter used by the extra threads
+
    TString fInputBranchName{"AtRawEvent"};
    TString fOutputBranchName{"AtRawEventFiltered"};
 
@@ -31,9 +38,14 @@ public:
 
    void SetPersistence(Bool_t value) { fIsPersistent = value; }
    void SetFilterAux(Bool_t value) { fFilterAux = value; }
+   /// Split the pads of each event over this many threads, each using its own clone of the filter
+   void SetNumThreads(Int_t numThreads) { fNumThreads = numThreads; }
    void SetInputBranch(TString name) { fInputBranchName = name; }
    void SetOutputBranch(TString name) { fOutputBranchName = name; }
    virtual InitStatus Init() override;
    virtual void Exec(Option_t *opt) override;
+
+private:
+   void FilterPads(AtFilter *filter, AtRawEvent *event, std::size_t begin, std::size_t end);
 };
 #endif //#ifndef ATFILTERTASK_H
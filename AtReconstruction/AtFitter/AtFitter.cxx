@@ -28,7 +28,7 @@ AtFITTER::AtFitter::AtFitter() = default;
 
 AtFITTER::AtFitter::~AtFitter() = default;
 
-std::tuple<Double_t, Double_t> AtFITTER::AtFitter::GetMomFromBrho(Double_t M, Double_t Z, Double_t brho)
+std::tuple<Double_t, Double_t> AtFITTER::AtFitter::GetMomFromBrho(Double_t M, Double_t Z, Double_t brho) const
 {
 
    const Double_t M_Ener = M * 931.49401 / 1000.0;
@@ -44,13 +44,13 @@ Bool_t AtFITTER::AtFitter::FindVertexTrack(AtTrack *trA, AtTrack *trB)
    Double_t vertexA = 0.0;
    Double_t vertexB = 0.0;
    if (trA->GetGeoTheta() * TMath::RadToDeg() < 90) {
-      auto iniClusterA = trA->GetHitClusterArray()->back();
-      auto iniClusterB = trB->GetHitClusterArray()->back();
+      const auto &iniClusterA = trA->GetHitClusterArray()->back();
+      const auto &iniClusterB = trB->GetHitClusterArray()->back();
       vertexA = 1000.0 - iniClusterA.GetPosition().Z();
       vertexB = 1000.0 - iniClusterB.GetPosition().Z();
    } else if (trA->GetGeoTheta() * TMath::RadToDeg() > 90) {
-      auto iniClusterA = trA->GetHitClusterArray()->front();
-      auto iniClusterB = trB->GetHitClusterArray()->front();
+      const auto &iniClusterA = trA->GetHitClusterArray()->front();
+      const auto &iniClusterB = trB->GetHitClusterArray()->front();
       vertexA = iniClusterA.GetPosition().Z();
       vertexB = iniClusterB.GetPosition().Z();
    }
@@ -111,8 +111,8 @@ Bool_t AtFITTER::AtFitter::MergeTracks(std::vector<AtTrack *> *trackCandSource,
       // Check relative position between end and begin of each track using Hit Clusters
       std::cout << " Vertex angle " << vertexTrack->GetGeoTheta() * TMath::RadToDeg() << "\n";
       if (vertexTrack->GetGeoTheta() * TMath::RadToDeg() < 90) {
-         auto endClusterVertex = vertexTrack->GetHitClusterArray()->front();
-         auto iniClusterMerge = trackToMerge->GetHitClusterArray()->back();
+         const auto &endClusterVertex = vertexTrack->GetHitClusterArray()->front();
+         const auto &iniClusterMerge = trackToMerge->GetHitClusterArray()->back();
          // Check separation and relative distance
          endVertexZ = 1000.0 - endClusterVertex.GetPosition().Z();
          iniMergeZ = 1000.0 - iniClusterMerge.GetPosition().Z();
@@ -125,8 +125,8 @@ Bool_t AtFITTER::AtFitter::MergeTracks(std::vector<AtTrack *> *trackCandSource,
          }
 
       } else if (vertexTrack->GetGeoTheta() * TMath::RadToDeg() > 90) {
-         auto endClusterVertex = vertexTrack->GetHitClusterArray()->back();
-         auto iniClusterMerge = trackToMerge->GetHitClusterArray()->front();
+         const auto &endClusterVertex = vertexTrack->GetHitClusterArray()->back();
+         const auto &iniClusterMerge = trackToMerge->GetHitClusterArray()->front();
          // Check separation and relative distance
          endVertexZ = endClusterVertex.GetPosition().Z();
          iniMergeZ = iniClusterMerge.GetPosition().Z();
@@ -185,9 +185,9 @@ AtFITTER::AtFitter::MergeTracks(std::vector<AtTrack> *trackCandSource, std::vect
    Int_t minClusters = 3;
    Int_t trackSize = 0;
 
-   for (auto trackCand : *trackCandSource) {
+   for (const auto &trackCand : *trackCandSource) {
       Double_t thetaCand = trackCand.GetGeoTheta();
-      auto hitArrayCand = trackCand.GetHitArray();
+      const auto &hitArrayCand = trackCand.GetHitArrayConst();
       std::pair<Double_t, Double_t> centerCand = trackCand.GetGeoCenter();
 
       AtTrack track = trackCand;
@@ -201,9 +201,9 @@ AtFITTER::AtFitter::MergeTracks(std::vector<AtTrack> *trackCandSource, std::vect
          thetaCand = thetaCand * TMath::RadToDeg();
       }
 
-      for (auto trackJunk : *trackJunkSource) {
+      for (const auto &trackJunk : *trackJunkSource) {
          Double_t thetaJunk = trackJunk.GetGeoTheta();
-         auto hitArrayJunk = trackJunk.GetHitArray();
+         const auto &hitArrayJunk = trackJunk.GetHitArrayConst();
          std::pair<Double_t, Double_t> centerJunk = trackJunk.GetGeoCenter();
 
          if (simulationConv) {
@@ -265,7 +265,7 @@ AtFITTER::AtFitter::MergeTracks(std::vector<AtTrack> *trackCandSource, std::vect
             track.GetHitArray().pop_back();
       }
 
-      trackDest->push_back(track);
+      trackDest->push_back(std::move(track));
 
    } // Source track
 }
@@ -44,7 +44,7 @@ protected:
    std::unique_ptr<AtTools::AtTrackTransformer> fTrackTransformer{std::make_unique<AtTools::AtTrackTransformer>()};
    std::tuple<Double_t, Double_t>
    GetMomFromBrho(Double_t A, Double_t Z,
-                  Double_t brho);                      ///< Returns momentum (in GeV) from Brho assuming M (amu) and Z;
+                  Double_t brho) const;                ///< Returns momentum (in GeV) from Brho assuming M (amu) and Z;
    Bool_t FindVertexTrack(AtTrack *trA, AtTrack *trB); ///< Lambda function to find track closer to vertex
    ClassDef(AtFitter, 1);
 };
@@ -39,6 +39,8 @@
 
 #include <algorithm>
 #include <iostream>
+#include <memory>
+#include <string>
 #include <tuple>
 #include <utility>
 
@@ -47,30 +49,30 @@ constexpr auto cYELLOW = "\033[1;33m";
 constexpr auto cNORMAL = "\033[0m";
 constexpr auto cGREEN = "\033[1;32m";
 
+namespace {
+/// Energy loss file and PDG code last passed to the material effects, shared by every fitter
+std::pair<std::string, Int_t> gEnergyLoss{"", 0};
+} // namespace
+
 AtFITTER::AtGenfit::AtGenfit(Float_t magfield, Float_t minbrho, Float_t maxbrho, std::string eLossFile,
                              Float_t gasMediumDensity, Int_t pdg, Int_t minit, Int_t maxit)
-   : fEnergyLossFile(std::move(eLossFile)),
-     fMeasurementProducer(
-        new genfit::MeasurementProducer<AtHitCluster, genfit::AtSpacepointMeasurement>(fHitClusterArray)),
-     fMeasurementFactory(new genfit::MeasurementFactory<genfit::AbsMeasurement>()), fMinIterations(minit),
-     fMaxIterations(maxit), fMinBrho(minbrho), fMaxBrho(maxbrho), fMagneticField(10.0 * magfield), fPDGCode(pdg),
-     fGenfitTrackArray(new TClonesArray("genfit::Track")), fHitClusterArray(new TClonesArray("AtHitCluster"))
+   : fEnergyLossFile(std::move(eLossFile)), fMinIterations(minit), fMaxIterations(maxit), fMinBrho(minbrho),
+     fMaxBrho(maxbrho), fMagneticField(10.0 * magfield), fPDGCode(pdg),
+     fGenfitTrackArray(new TClonesArray("genfit::Track"))
 {
-   fKalmanFitter = std::make_shared<genfit::KalmanFitterRefTrack>();
-   fKalmanFitter->setMinIterations(fMinIterations);
-   fKalmanFitter->setMaxIterations(fMaxIterations);
-   // fKalmanFitter->setDebugLvl();
-   fMeasurementFactory->addProducer(fTPCDetID, fMeasurementProducer);
-
-   genfit::FieldManager::getInstance()->init(new genfit::ConstField(0., 0., fMagneticField)); // TODO kGauss
+   // The field and material effects are shared by every fitter, so only the first one sets them up. The energy
+   // loss of the particle is selected by FitTrack.
+   if (!genfit::FieldManager::getInstance()->isInitialized())
+      genfit::FieldManager::getInstance()->init(new genfit::ConstField(0., 0., fMagneticField)); // TODO kGauss
    genfit::MaterialEffects *materialEffects = genfit::MaterialEffects::getInstance();
-   materialEffects->setEnergyLossBrems(false);
-   materialEffects->setNoiseBrems(false);
-   materialEffects->useEnergyLossParam();
-   materialEffects->init(new genfit::TGeoMaterialInterface());
-   // Parameteres set after initialization
-   materialEffects->setGasMediumDensity(gasMediumDensity);
-   materialEffects->setEnergyLossFile(fEnergyLossFile, fPDGCode);
+   if (!materialEffects->isInitialized()) {
+      materialEffects->setEnergyLossBrems(false);
+      materialEffects->setNoiseBrems(false);
+      materialEffects->useEnergyLossParam();
+      materialEffects->init(new genfit::TGeoMaterialInterface());
+      // Parameteres set after initialization
+      materialEffects->setGasMediumDensity(gasMediumDensity);
+   }
 
    // fPDGCandidateArray = new std::vector<Int_t>; // TODO
    // fPDGCandidateArray->push_back(2212);
@@ -124,11 +126,7 @@ AtFITTER::AtGenfit::AtGenfit(Float_t magfield, Float_t minbrho, Float_t maxbrho,
 
 AtFITTER::AtGenfit::~AtGenfit()
 {
-   // delete fKalmanFitter;
    delete fGenfitTrackArray;
-   delete fHitClusterArray;
-   delete fMeasurementProducer;
-   delete fMeasurementFactory;
    delete fPDGCandidateArray;
 }
 
@@ -138,7 +136,6 @@ void AtFITTER::AtGenfit::Init()
    // std::cout << cGREEN << " PDG : "<<fPDGCode<<"\n";
    // std::cout << cGREEN << " Ion : "<<fIonName<<"\n";
 
-   fHitClusterArray->Delete();
    fGenfitTrackArray->Delete();
 }
 
@@ -148,40 +145,62 @@ TClonesArray *AtFITTER::AtGenfit::GetGenfitTrackArray()
 }
 
 /**
- * Angles from track are used to construct the direction of the initial momentum of the track.
- * Radius from track is used to construct the magnitude of the initial momentum of the track.
+ * Fit track and keep the result in fGenfitTrackArray, which is cleared by Init().
+ * Use FitTrack to get the result without a copy.
  */
 genfit::Track *AtFITTER::AtGenfit::FitTracks(AtTrack *track)
 {
+   auto fitTrack = FitTrack(*track);
+   if (fitTrack == nullptr)
+      return nullptr;
+   return new ((*fGenfitTrackArray)[fGenfitTrackArray->GetEntriesFast()]) genfit::Track(*fitTrack);
+}
 
-   // std::vector<genfit::Track> genfitTrackArray;
+/**
+ * Angles from track are used to construct the direction of the initial momentum of the track.
+ * Radius from track is used to construct the magnitude of the initial momentum of the track.
+ *
+ * The Kalman fitter, measurement producer and hit clusters are local to each call, and track is not
+ * modified. The energy loss of the particle is loaded into genfit's material effects (shared by every
+ * fitter) when it differs from the last fit, so fit the tracks of each particle together.
+ */
+std::unique_ptr<genfit::Track> AtFITTER::AtGenfit::FitTrack(const AtTrack &track) const
+{
+   if (gEnergyLoss.first != fEnergyLossFile || gEnergyLoss.second != fPDGCode) {
+      genfit::MaterialEffects::getInstance()->setEnergyLossFile(fEnergyLossFile, fPDGCode);
+      gEnergyLoss = {fEnergyLossFile, fPDGCode};
+   }
 
-   // std::vector<AtTrack> &patternTrackCand = patternEvent.GetTrackCand();
+   genfit::KalmanFitterRefTrack kalmanFitter;
+   kalmanFitter.setMinIterations(fMinIterations);
+   kalmanFitter.setMaxIterations(fMaxIterations);
 
-   // std::cout << cGREEN << " AtFITTER::AtGenfit::FitTracks - Number of candidate tracks : " << patternTrackCand.size()
-   //<< cNORMAL << "\n";
+   // The factory owns the producer, which reads the hit clusters added to hitClusterArray
+   TClonesArray hitClusterArray("AtHitCluster");
+   genfit::MeasurementFactory<genfit::AbsMeasurement> measurementFactory;
+   measurementFactory.addProducer(
+      fTPCDetID, new genfit::MeasurementProducer<AtHitCluster, genfit::AtSpacepointMeasurement>(&hitClusterArray));
 
-   // for (auto track : patternTrackCand) {
-   fHitClusterArray->Delete();
    genfit::TrackCand trackCand;
 
-   auto hitClusterArray = track->GetHitClusterArray();
+   // Copy, so the clusters can be reversed without touching the track
+   auto hitClusters = track.GetHitClusterArrayConst();
 
    TVector3 pos_res;
    TVector3 mom_res;
    TMatrixDSym cov_res;
 
-   std::cout << cYELLOW << " Track " << track->GetTrackID() << " with " << hitClusterArray->size() << " clusters "
+   std::cout << cYELLOW << " Track " << track.GetTrackID() << " with " << hitClusters.size() << " clusters "
              << cNORMAL << "\n";
 
-   if (hitClusterArray->size() < 3) //&& patternTrackCand.size()<5) { // TODO Check minimum number of clusters
+   if (hitClusters.size() < 3) //&& patternTrackCand.size()<5) { // TODO Check minimum number of clusters
       return nullptr;
 
    if (fVerbosity > 0) {
       std::cout << " Initial angles from PRA "
                 << "\n";
-      std::cout << " Theta : " << TMath::RadToDeg() * track->GetGeoTheta()
-                << " - Phi : " << TMath::RadToDeg() * track->GetGeoPhi() << "\n";
+      std::cout << " Theta : " << TMath::RadToDeg() * track.GetGeoTheta()
+                << " - Phi : " << TMath::RadToDeg() * track.GetGeoPhi() << "\n";
    }
 
    // New angle convention
@@ -191,40 +210,39 @@ genfit::Track *AtFITTER::AtGenfit::FitTracks(AtTrack *track)
    // Variable for convention (simulation comes reversed)
    Double_t thetaConv;
    if (fSimulationConv) {
-      thetaConv = 180.0 * TMath::DegToRad() - track->GetGeoTheta();
+      thetaConv = 180.0 * TMath::DegToRad() - track.GetGeoTheta();
    } else {
-      thetaConv = track->GetGeoTheta();
+      thetaConv = track.GetGeoTheta();
    }
 
    if (IsForwardTrack(thetaConv)) { // Forward (Backward) for experiment (simulation)
 
       if (fSimulationConv) {
-         theta = 180.0 * TMath::DegToRad() - track->GetGeoTheta();
-         phi = track->GetGeoPhi();
+         theta = 180.0 * TMath::DegToRad() - track.GetGeoTheta();
+         phi = track.GetGeoPhi();
       } else {
-         theta = track->GetGeoTheta();
-         phi = track->GetGeoPhi(); // 180.0 * TMath::DegToRad() - track->GetGeoPhi();
+         theta = track.GetGeoTheta();
+         phi = track.GetGeoPhi(); // 180.0 * TMath::DegToRad() - track.GetGeoPhi();
       }
 
-      // Needs to be reversed back for multifit
-      std::reverse(hitClusterArray->begin(), hitClusterArray->end());
+      std::reverse(hitClusters.begin(), hitClusters.end());
 
    } else if (thetaConv > 90.0 * TMath::DegToRad()) { // Backward (Forward) for experiment (simulation)
 
       if (fSimulationConv) {
-         theta = track->GetGeoTheta();
-         phi = 180.0 * TMath::DegToRad() - track->GetGeoPhi(); // 180.0 * TMath::DegToRad() - track->GetGeoPhi();
+         theta = track.GetGeoTheta();
+         phi = 180.0 * TMath::DegToRad() - track.GetGeoPhi(); // 180.0 * TMath::DegToRad() - track.GetGeoPhi();
       } else {
-         theta = 180.0 * TMath::DegToRad() - track->GetGeoTheta();
-         phi = -track->GetGeoPhi();
+         theta = 180.0 * TMath::DegToRad() - track.GetGeoTheta();
+         phi = -track.GetGeoPhi();
       }
    } else {
-      std::cout << cRED << " AtGenfit::FitTracks - Warning! Undefined theta angle. Skipping event..." << cNORMAL
+      std::cout << cRED << " AtGenfit::FitTrack - Warning! Undefined theta angle. Skipping event..." << cNORMAL
                 << "\n";
       return nullptr;
    }
 
-   Double_t radius = track->GetGeoRadius() / 1000.0; // mm to m
+   Double_t radius = track.GetGeoRadius() / 1000.0; // mm to m
 
    Double_t brho = (fMagneticField / 10.0) * radius / TMath::Sin(theta); // Tm
 
@@ -242,12 +260,12 @@ genfit::Track *AtFITTER::AtGenfit::FitTracks(AtTrack *track)
                 << "    - Brho (geo) : " << brho << cNORMAL << "\n";
    }
 
-   // hitClusterArray->resize(hitClusterArray->size() * 0.50);
+   // hitClusters.resize(hitClusters.size() * 0.50);
 
    // Adding clusterized  hits
-   // for (auto cluster : *hitClusterArray) {
-   for (auto iCluster = 0; iCluster < hitClusterArray->size(); ++iCluster) {
-      auto cluster = hitClusterArray->at(iCluster);
+   // for (auto cluster : hitClusters) {
+   for (auto iCluster = 0; iCluster < hitClusters.size(); ++iCluster) {
+      const auto &cluster = hitClusters.at(iCluster);
       auto pos = cluster.GetPosition();
       auto clusterClone(cluster);
 
@@ -255,7 +273,7 @@ genfit::Track *AtFITTER::AtGenfit::FitTracks(AtTrack *track)
          std::cout << cYELLOW << "    First cluster : " << pos.X() << " - " << pos.Y() << " - " << pos.Z() << cNORMAL
                    << "\n";
 
-      } else if (iCluster == (hitClusterArray->size() - 1)) {
+      } else if (iCluster == (hitClusters.size() - 1)) {
 
          std::cout << cYELLOW << "    Last cluster : " << pos.X() << " - " << pos.Y() << " - " << pos.Z() << cNORMAL
                    << "\n";
@@ -273,8 +291,8 @@ genfit::Track *AtFITTER::AtGenfit::FitTracks(AtTrack *track)
             clusterClone.SetPosition({-pos.X(), pos.Y(), pos.Z()});
       }
 
-      Int_t idx = fHitClusterArray->GetEntriesFast();
-      new ((*fHitClusterArray)[idx]) AtHitCluster(clusterClone);
+      Int_t idx = hitClusterArray.GetEntriesFast();
+      new (hitClusterArray[idx]) AtHitCluster(clusterClone);
       trackCand.addHit(fTPCDetID, idx);
       // std::cout<<" Adding  cluster "<<idx<<"\n";
       // std::cout<<pos.X()<<"     "<<pos.Y()<<"   "<<pos.Z()<<"\n";
@@ -292,8 +310,8 @@ genfit::Track *AtFITTER::AtGenfit::FitTracks(AtTrack *track)
 
    // Initial track position
    if (IsForwardTrack(thetaConv)) {
-      iniCluster = hitClusterArray->front();
-      // iniCluster = hitClusterArray->back();
+      iniCluster = hitClusters.front();
+      // iniCluster = hitClusters.back();
       iniPos = iniCluster.GetPosition();
       zIniCal = 1000.0 - iniPos.Z();
 
@@ -302,12 +320,9 @@ genfit::Track *AtFITTER::AtGenfit::FitTracks(AtTrack *track)
       else
          xIniCal = -iniPos.X();
 
-      // Leave hit cluster array in its original state
-      std::reverse(hitClusterArray->begin(), hitClusterArray->end());
-
    } else if (thetaConv > 90.0 * TMath::DegToRad()) {
-      iniCluster = hitClusterArray->front();
-      // iniCluster = hitClusterArray->back();
+      iniCluster = hitClusters.front();
+      // iniCluster = hitClusters.back();
       iniPos = iniCluster.GetPosition();
       zIniCal = iniPos.Z();
 
@@ -317,7 +332,7 @@ genfit::Track *AtFITTER::AtGenfit::FitTracks(AtTrack *track)
          xIniCal = -iniPos.X();
 
    } else {
-      std::cout << cRED << " AtGenfit::FitTracks - Warning! Undefined theta angle. Skipping event..." << cNORMAL
+      std::cout << cRED << " AtGenfit::FitTrack - Warning! Undefined theta angle. Skipping event..." << cNORMAL
                 << "\n";
    }
 
@@ -371,15 +386,14 @@ genfit::Track *AtFITTER::AtGenfit::FitTracks(AtTrack *track)
    if (brho > fMaxBrho && brho < fMinBrho)
       return nullptr;
 
-   auto *gfTrack =
-      new ((*fGenfitTrackArray)[fGenfitTrackArray->GetEntriesFast()]) genfit::Track(trackCand, *fMeasurementFactory);
+   auto gfTrack = std::make_unique<genfit::Track>(trackCand, measurementFactory);
    gfTrack->addTrackRep(new genfit::RKTrackRep(fPDGCode));
 
    auto *trackRep = dynamic_cast<genfit::RKTrackRep *>(gfTrack->getTrackRep(0));
    // trackRep->setPropDir(-1);
 
    try {
-      fKalmanFitter->processTrackWithRep(gfTrack, trackRep, false);
+      kalmanFitter.processTrackWithRep(gfTrack.get(), trackRep, false);
    } catch (genfit::Exception &e) {
       std::cout << " AtGenfit -  Exception caught from Kalman Fitter : " << e.what() << "\n";
       return nullptr;
@@ -19,23 +19,11 @@ class TClass;
 class TClonesArray;
 class TMemberInspector;
 
-namespace genfit {
-class AbsKalmanFitter;
-class AbsMeasurement;
-class AtSpacepointMeasurement;
-template <class hit_T, class measurement_T>
-class MeasurementProducer;
-template <class measurement_T>
-class MeasurementFactory;
-} // namespace genfit
-
 namespace AtFITTER {
 
 class AtGenfit : public AtFitter {
 private:
-   std::shared_ptr<genfit::AbsKalmanFitter> fKalmanFitter;
-   TClonesArray *fGenfitTrackArray;
-   TClonesArray *fHitClusterArray;
+   TClonesArray *fGenfitTrackArray; //< Tracks fit by FitTracks
    Int_t fPDGCode{2212}; //<! Particle PGD code
    Int_t fTPCDetID{0};
    Int_t fCurrentDirection{-1};
@@ -54,9 +42,6 @@ private:
    Double_t fPhiOrientation{0};   //<! Phi angle orientation for fit
    std::string fIonName;          //<! Name of ion to fit
 
-   genfit::MeasurementProducer<AtHitCluster, genfit::AtSpacepointMeasurement> *fMeasurementProducer;
-   genfit::MeasurementFactory<genfit::AbsMeasurement> *fMeasurementFactory;
-
    std::vector<Int_t> *fPDGCandidateArray{};
 
 public:
@@ -65,6 +50,8 @@ public:
    ~AtGenfit();
 
    genfit::Track *FitTracks(AtTrack *track) override;
+   /// Fit track without modifying it, returning nullptr if the fit fails
+   std::unique_ptr<genfit::Track> FitTrack(const AtTrack &track) const;
    void Init() override;
 
    inline void SetMinIterations(Int_t minit) { fMinIterations = minit; }
@@ -88,8 +75,8 @@ public:
    std::string &GetIonName() { return fIonName; }
 
 protected:
-   inline bool IsForwardTrack(double theta) { return theta < 90.0 * TMath::DegToRad(); }
-   ClassDefOverride(AtGenfit, 1);
+   inline bool IsForwardTrack(double theta) const { return theta < 90.0 * TMath::DegToRad(); }
+   ClassDefOverride(AtGenfit, 2);
 };
 
 } // namespace AtFITTER
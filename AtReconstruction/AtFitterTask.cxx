@@ -15,10 +15,8 @@
 #include <TObject.h>
 #include <Track.h>
 
-#include <algorithm>
 #include <iostream>
-
-class AtTrack;
+#include <utility>
 
 constexpr auto cRED = "\033[1;31m";
 constexpr auto cYELLOW = "\033[1;33m";
@@ -61,22 +59,31 @@ InitStatus AtFitterTask::Init()
       std::cout << cGREEN << " AtFitterTask::Init - Fit parameters. "
                 << "\n";
       std::cout << " Magnetic Field       : " << fMagneticField << " T\n";
-      std::cout << " PDG Code             : " << fPDGCode << "\n";
-      std::cout << " Mass                 : " << fMass << " amu\n";
-      std::cout << " Atomic Number        : " << fAtomicNumber << "\n";
       std::cout << " Number of fit points : " << fNumFitPoints << "\n";
       std::cout << " Maximum iterations   : " << fMaxIterations << "\n";
       std::cout << " Minimum iterations   : " << fMinIterations << "\n";
       std::cout << " Maximum brho         : " << fMaxBrho << "\n";
       std::cout << " Minimum brho         : " << fMinBrho << "\n";
       std::cout << " Energy loss file     : " << fELossFile << "\n";
+      if (fHypotheses.empty())
+         fHypotheses.push_back({fPDGCode, fMass, fAtomicNumber});
+      for (const auto &hyp : fHypotheses) {
+         std::cout << " PDG Code             : " << hyp.pdg << "\n";
+         std::cout << " Mass                 : " << hyp.mass << " amu\n";
+         std::cout << " Atomic Number        : " << hyp.atomicNumber << "\n";
+      }
       std::cout << " --------------------------------------------- " << cNORMAL << "\n";
 
-      fFitter = new AtFITTER::AtGenfit(fMagneticField, fMinBrho, fMaxBrho, fELossFile, fMinIterations, fMaxIterations);
-      dynamic_cast<AtFITTER::AtGenfit *>(fFitter)->SetPDGCode(fPDGCode);
-      dynamic_cast<AtFITTER::AtGenfit *>(fFitter)->SetMass(fMass);
-      dynamic_cast<AtFITTER::AtGenfit *>(fFitter)->SetAtomicNumber(fAtomicNumber);
-      dynamic_cast<AtFITTER::AtGenfit *>(fFitter)->SetNumFitPoints(fNumFitPoints);
+      fFitters.clear();
+      for (const auto &hyp : fHypotheses) {
+         auto fitter = std::make_unique<AtFITTER::AtGenfit>(fMagneticField, fMinBrho, fMaxBrho, fELossFile,
+                                                            fMinIterations, fMaxIterations);
+         fitter->SetPDGCode(hyp.pdg);
+         fitter->SetMass(hyp.mass);
+         fitter->SetAtomicNumber(hyp.atomicNumber);
+         fitter->SetNumFitPoints(fNumFitPoints);
+         fFitters.push_back(std::move(fitter));
+      }
 
    } else if (fFitterAlgorithm == 1) {
       LOG(error) << "Fitter algorithm not defined!";
@@ -86,7 +93,6 @@ InitStatus AtFitterTask::Init()
       return kERROR;
    }
 
-   // ioMan -> Register("genfitTrackTCA","ATTPC",fGenfitTrackArray, fIsPersistence);
    ioMan->RegisterAny("ATTPC", fGenfitTrackVector, fIsPersistence);
 
    return kSUCCESS;
@@ -117,63 +123,29 @@ void AtFitterTask::Exec(Option_t *option)
    fGenfitTrackArray->Clear("C");
    fGenfitTrackVector->clear();
 
-   fFitter->Init();
+   for (auto &fitter : fFitters)
+      fitter->Init();
 
    std::cout << " Event Counter " << fEventCnt << "\n";
 
    AtPatternEvent &patternEvent = *(dynamic_cast<AtPatternEvent *>(fPatternEventArray->At(0)));
-   std::vector<AtTrack> &patternTrackCand = patternEvent.GetTrackCand();
+   const std::vector<AtTrack> &patternTrackCand = patternEvent.GetTrackCand();
    std::cout << " AtFitterTask:Exec -  Number of candidate tracks : " << patternTrackCand.size() << "\n";
 
-   if (patternTrackCand.size() < 10) {
-
-      for (auto track : patternTrackCand) {
+   if (fMaxNumTracks > 0 && patternTrackCand.size() > static_cast<std::size_t>(fMaxNumTracks)) {
+      ++fEventCnt;
+      return;
+   }
 
-         genfit::Track *fitTrack = fFitter->FitTracks(&track);
+   // Fit every track with one hypothesis before moving to the next, so genfit only loads the energy loss of each
+   // particle once per event
+   for (auto &fitter : fFitters) {
+      for (const auto &track : patternTrackCand) {
+         auto fitTrack = fitter->FitTrack(track);
          if (fitTrack != nullptr)
-            fGenfitTrackVector->push_back(*static_cast<genfit::Track *>(fitTrack));
+            fGenfitTrackVector->push_back(*fitTrack);
       }
    }
 
-   /*if(patternTrackCand.size()>1){
-     genfit::Track *fitTrack=fFitter->FitTracks(&patternTrackCand.at(1));
-   if(fitTrack!=nullptr)fGenfitTrackVector->push_back(*static_cast<genfit::Track *>(fitTrack));
-   }*/
-
-   // if(fitTrack==nullptr)
-   // std::cout<<" Nullptr "<<"\n";
-
-   //}
-
-   // }
-
-   // TODO: Genfit block, add a dynamic cast and a try-catch
-
-   /*try {
-      auto genfitTrackArray = dynamic_cast<AtFITTER::AtGenfit *>(fFitter)->GetGenfitTrackArray();
-      auto genfitTracks = genfitTrackArray->GetEntriesFast();
-
-       for (auto iTrack = 0; iTrack < genfitTracks; ++iTrack) {
-         new ((*fGenfitTrackArray)[iTrack]) genfit::Track(*static_cast<genfit::Track *>(genfitTrackArray->At(iTrack)));
-         // auto trackTest = *static_cast<genfit::Track*>(genfitTrackArray->At(iTrack));
-         // trackTest.Print();
-         // genfit::MeasuredStateOnPlane fitState = trackTest.getFittedState();
-         // fitState.Print();
-         fGenfitTrackVector->push_back(*static_cast<genfit::Track *>(genfitTrackArray->At(iTrack)));
-    }
-
-      //auto genfitTracks_ = fGenfitTrackArray->GetEntriesFast();
-      //for(auto iTrack=0;iTrack<genfitTracks_;++iTrack){
-
-        //      auto trackTest = *static_cast<genfit::Track*>(fGenfitTrackArray->At(iTrack));
-         //     trackTest.Print();
-         //     genfit::MeasuredStateOnPlane fitState = trackTest.getFittedState();
-          //    fitState.Print();
-      //}
-
-   } catch (std::exception &e) {
-      std::cout << " " << e.what() << "\n";
-      }*/
-
    ++fEventCnt;
 }
@@ -13,6 +13,7 @@
 #include <FairTask.h>
 
 #include <cstddef>
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -24,7 +25,7 @@ class TClonesArray;
 class TMemberInspector;
 
 namespace AtFITTER {
-class AtFitter;
+class AtGenfit;
 } // namespace AtFITTER
 namespace genfit {
 class Track;
@@ -52,13 +53,27 @@ public:
    inline void SetMaxBrho(Float_t maxbrho) { fMaxBrho = maxbrho; }
    inline void SetMinBhro(Float_t minbrho) { fMinBrho = minbrho; }
    inline void SetELossFile(std::string file) { fELossFile = file; }
+   /**
+    * Also fit every track as the particle pdg, with mass in amu and atomic number znum. Without any added
+    * hypothesis, each track is fit once using SetPDGCode, SetMass and SetAtomicNumber. The fit tracks are
+    * stored grouped by hypothesis, in the order they were added.
+    */
+   void AddHypothesis(Int_t pdg, Float_t mass, Int_t znum) { fHypotheses.push_back({pdg, mass, znum}); }
+   /// Events with more candidate tracks than this are not fit (0 fits every event)
+   inline void SetMaxNumTracks(Int_t maxNumTracks) { fMaxNumTracks = maxNumTracks; }
 
 private:
+   struct Hypothesis {
+      Int_t pdg;
+      Float_t mass;
+      Int_t atomicNumber;
+   };
+
    Bool_t fIsPersistence; //!< Persistence check variable
    FairLogger *fLogger;
    AtDigiPar *fPar{nullptr};
    TClonesArray *fPatternEventArray;
-   AtFITTER::AtFitter *fFitter{};
+   std::vector<std::unique_ptr<AtFITTER::AtGenfit>> fFitters; //! One fitter per hypothesis
    Int_t fFitterAlgorithm{0};
 
    TClonesArray *fGenfitTrackArray;
@@ -75,8 +90,10 @@ private:
    Float_t fMaxBrho{3.0};
    Float_t fMinBrho{0.01};
    std::string fELossFile{""};
+   std::vector<Hypothesis> fHypotheses; //!
+   Int_t fMaxNumTracks{0};
 
-   ClassDef(AtFitterTask, 1);
+   ClassDef(AtFitterTask, 3);
 };
 
 #endif
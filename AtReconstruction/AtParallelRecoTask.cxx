@@ -0,0 +1,233 @@
+#include "AtParallelRecoTask.h"
+
+#include "AtEvent.h"
+#include "AtFilter.h"
+#include "AtPRA.h"
+#include "AtPSA.h"
+#include "AtPad.h"
+#include "AtPatternEvent.h"
+#include "AtRawEvent.h"
+#include "AtUnpacker.h"
+
+#include <FairLogger.h>
+#include <FairRootManager.h>
+#include <FairTask.h>
+
+#include <TClonesArray.h>
+#include <TObject.h>
+#include <TROOT.h>
+#include <TRandom.h>
+
+#include <algorithm>
+#include <functional>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <utility>
+
+ClassImp(AtParallelRecoTask);
+
+void AtParallelRecoTask::EventSlot::Clear()
+{
+   fRawEvent.Clear();
+   fFilteredEventArray.Delete();
+   fEvent.Clear();
+   fPatternEvent.reset();
+}
+
+AtParallelRecoTask::AtParallelRecoTask(std::unique_ptr<AtUnpacker> unpacker, std::unique_ptr<AtPSA> psa)
+   : FairTask("AtParallelRecoTask"), fRawEventArray("AtRawEvent", 1), fFilteredEventArray("AtRawEvent", 1),
+     fEventArray("AtEvent", 1), fPatternEventArray("AtPatternEvent", 1), fUnpacker(std::move(unpacker)),
+     fPSA(std::move(psa))
+{
+}
+
+AtParallelRecoTask::~AtParallelRecoTask() = default;
+
+InitStatus AtParallelRecoTask::Init()
+{
+   FairRootManager *ioMan = FairRootManager::Instance();
+   if (ioMan == nullptr) {
+      LOG(fatal) << "Cannot find RootManager!";
+      return kFATAL;
+   }
+
+   if (fNumThreads < 1) {
+      LOG(error) << "Number of threads must be at least one, got " << fNumThreads;
+      return kERROR;
+   }
+   if (fBatchSize < 1)
+      fBatchSize = 4 * fNumThreads;
+
+   // Required for ROOT classes (TClonesArray, TSpectrum, etc) to be constructed from the workers
+   ROOT::EnableThreadSafety();
+
+   fUnpacker->Init();
+   fPSA->Init();
+
+   // Each worker gets its own copy of the algorithms so no state is shared between threads
+   fWorkers.clear();
+   for (int i = 0; i < fNumThreads; ++i) {
+      Worker worker;
+      worker.fPSA = fPSA->Clone();
+      if (fFilter) {
+         worker.fFilter = fFilter->Clone();
+         worker.fFilter->Init();
+      }
+      if (fPRA)
+         worker.fPRA = fPRA->Clone();
+      fWorkers.push_back(std::move(worker));
+   }
+
+   fSlots.clear();
+   for (int i = 0; i < fBatchSize; ++i)
+      fSlots.push_back(std::make_unique<EventSlot>());
+
+   ioMan->Register(fRawEventBranchName, "AtTPC", &fRawEventArray, fIsRawEventPersistent);
+   if (fFilter)
+      ioMan->Register(fFilteredEventBranchName, "AtTPC", &fFilteredEventArray, fIsFilteredEventPersistent);
+   ioMan->Register(fEventBranchName, "AtTPC", &fEventArray, fIsEventPersistent);
+   if (fPRA)
+      ioMan->Register(fPatternEventBranchName, "AtTPC", &fPatternEventArray, fIsPatternEventPersistent);
+
+   LOG(info) << "Running reconstruction on " << fNumThreads << " threads with " << fBatchSize
+             << " events per batch";
+
+   return kSUCCESS;
+}
+
+void AtParallelRecoTask::Exec(Option_t *opt)
+{
+   if (fNextSlotToWrite >= fNumSlotsFilled) {
+      if (fFinishedUnpacking) {
+         LOG(warn) << "Hit last event at: " << fUnpacker->GetNextEventID();
+         fRawEventArray.Clear("C");
+         dynamic_cast<AtRawEvent *>(fRawEventArray.ConstructedAt(0))->SetIsGood(false);
+         fFilteredEventArray.Delete();
+         fEventArray.Clear("C");
+         fPatternEventArray.Delete();
+         return;
+      }
+      FillAndProcessBatch();
+   }
+
+   WriteSlot(*fSlots[fNextSlotToWrite++]);
+}
+
+void AtParallelRecoTask::FinishEvent()
+{
+   // See AtUnpackTask::FinishEvent(), this is not called for a run without a source
+   if (fFinishedUnpacking && fNextSlotToWrite >= fNumSlotsFilled) {
+      LOG(info) << "Reconstructed last event. Terminating run.";
+      FairRootManager::Instance()->SetFinishRun();
+   }
+}
+
+/**
+ * Unpack the next batch of events (unpackers are not thread safe so this is done serially) and then
+ * process every event in the batch in parallel.
+ */
+void AtParallelRecoTask::FillAndProcessBatch()
+{
+   fNumSlotsFilled = 0;
+   fNextSlotToWrite = 0;
+   while (fNumSlotsFilled < fBatchSize && !fFinishedUnpacking) {
+      auto &slot = *fSlots[fNumSlotsFilled++];
+      slot.Clear();
+
+      LOG(debug) << "Unpacking event: " << fUnpacker->GetNextEventID();
+      fUnpacker->FillRawEvent(slot.fRawEvent);
+      fFinishedUnpacking = fUnpacker->IsLastEvent();
+      if (fPRA)
+         slot.fSeed = gRandom->Integer(kMaxUInt) + 1; // gRandom is only used here, on the main thread
+   }
+
+   fNextSlotToProcess = 0;
+   auto numThreads = std::min<Int_t>(fWorkers.size(), fNumSlotsFilled);
+   if (numThreads <= 1) {
+      ProcessSlots(fWorkers.front());
+      return;
+   }
+
+   std::vector<std::thread> threads;
+   for (int i = 0; i < numThreads; ++i)
+      threads.emplace_back([this](Worker &worker) { this->ProcessSlots(worker); }, std::ref(fWorkers[i]));
+   for (auto &thread : threads)
+      thread.join();
+}
+
+/// Process slots in the current batch until there are none left. Events are claimed dynamically to balance load.
+void AtParallelRecoTask::ProcessSlots(Worker &worker)
+{
+   for (Int_t idx = fNextSlotToProcess++; idx < fNumSlotsFilled; idx = fNextSlotToProcess++)
+      ProcessEvent(worker, *fSlots[idx]);
+}
+
+void AtParallelRecoTask::ProcessEvent(Worker &worker, EventSlot &slot)
+{
+   AtRawEvent *rawEvent = &slot.fRawEvent;
+
+   // Filter (mirrors AtFilterTask::Exec)
+   if (worker.fFilter) {
+      worker.fFilter->InitEvent(rawEvent);
+      auto filteredEvent = worker.fFilter->ConstructOutputEvent(&slot.fFilteredEventArray, rawEvent);
+
+      if (rawEvent->IsGood()) {
+         if (fFilterAux)
+            for (const auto &[auxName, auxPad] : filteredEvent->GetAuxPads())
+               worker.fFilter->Filter(filteredEvent->GetAuxPad(auxName));
+
+         for (const auto &pad : filteredEvent->GetPads())
+            worker.fFilter->Filter(pad.get());
+
+         filteredEvent->SetIsGood(filteredEvent->IsGood() && worker.fFilter->IsGoodEvent());
+      }
+      rawEvent = filteredEvent;
+   }
+
+   // PSA (mirrors AtPSAtask::Exec)
+   slot.fEvent.CopyFrom(*rawEvent);
+   if (!rawEvent->IsGood()) {
+      LOG(debug) << "Event " << rawEvent->GetEventID() << " is not good, skipping PSA";
+      return;
+   }
+   worker.fPSA->Analyze(rawEvent, &slot.fEvent);
+
+   // Pattern recognition (mirrors AtPRAtask::Exec)
+   if (!worker.fPRA)
+      return;
+   auto numHits = slot.fEvent.GetNumHits();
+   if (numHits <= fMinNumHits || numHits >= fMaxNumHits)
+      return;
+
+   try {
+      worker.fPRA->SetEventSeed(slot.fSeed);
+      slot.fPatternEvent = worker.fPRA->FindTracks(slot.fEvent);
+   } catch (std::runtime_error &e) {
+      LOG(error) << "Pattern recognition failed on event " << slot.fEvent.GetEventID() << "! Error: " << e.what();
+   }
+}
+
+/// Move the processed event in the slot into the arrays registered with FairRoot
+void AtParallelRecoTask::WriteSlot(EventSlot &slot)
+{
+   auto rawEvent = dynamic_cast<AtRawEvent *>(fRawEventArray.ConstructedAt(0, "C"));
+   *rawEvent = std::move(slot.fRawEvent);
+
+   if (fFilter) {
+      fFilteredEventArray.Delete();
+      if (slot.fFilteredEventArray.GetEntriesFast() > 0) {
+         auto filteredEvent = dynamic_cast<AtRawEvent *>(slot.fFilteredEventArray.At(0));
+         new (fFilteredEventArray[0]) AtRawEvent(std::move(*filteredEvent)); // NOLINT (ROOT owns memory)
+      }
+   }
+
+   auto event = dynamic_cast<AtEvent *>(fEventArray.ConstructedAt(0, "C"));
+   *event = slot.fEvent;
+
+   fPatternEventArray.Delete();
+   if (slot.fPatternEvent)
+      new (fPatternEventArray[0]) AtPatternEvent(std::move(*slot.fPatternEvent)); // NOLINT (ROOT owns memory)
+
+   LOG(debug) << "Wrote reconstructed event " << event->GetEventID();
+}
@@ -0,0 +1,134 @@
+/*
+ * Task for running the reconstruction chain (unpack -> filter -> PSA -> PRA) in parallel over events.
+ *
+ * Events are unpacked serially into a batch of slots. The batch is then processed by a pool of workers,
+ * each owning its own clone of the filter, PSA, and PRA, and a private copy of the event being processed.
+ * Processed events are handed back to FairRoot one at a time, in the order they were unpacked, so the
+ * output tree is identical to running AtUnpackTask, AtFilterTask, AtPSAtask, and AtPRAtask in sequence, except
+ * for the random sampling of the PRA. It is seeded once per event, from gRandom when the event is unpacked, so
+ * it is reproducible and independent of the number of threads.
+ *
+ * This task replaces those tasks in the run, and it must be the only task producing the branches it writes.
+ * Tracking of Monte Carlo points in the PSA is not supported in this mode.
+ *
+ */
+#ifndef ATPARALLELRECOTASK_H
+#define ATPARALLELRECOTASK_H
+
+#include "AtEvent.h"
+#include "AtFilter.h"
+#include "AtPRA.h"
+#include "AtPSA.h"
+#include "AtPatternEvent.h"
+#include "AtRawEvent.h"
+#include "AtUnpacker.h"
+
+#include <FairTask.h>
+
+#include <Rtypes.h>
+#include <TClonesArray.h>
+#include <TString.h>
+
+#include <atomic>
+#include <memory>
+#include <utility>
+#include <vector>
+
+class TBuffer;
+class TClass;
+class TMemberInspector;
+
+class AtParallelRecoTask : public FairTask {
+private:
+   // Per-event storage used while processing a batch
+   struct EventSlot {
+      AtRawEvent fRawEvent;
+      TClonesArray fFilteredEventArray{"AtRawEvent", 1};
+      AtEvent fEvent;
+      std::unique_ptr<AtPatternEvent> fPatternEvent;
+      UInt_t fSeed{0}; //< Seed of the random sampling of the PRA
+
+      void Clear();
+   };
+
+   // Algorithms owned by a single worker thread
+   struct Worker {
+      std::unique_ptr<AtFilter> fFilter;
+      std::unique_ptr<AtPSA> fPSA;
+      std::unique_ptr<AtPATTERN::AtPRA> fPRA;
+   };
+
+   TString fRawEventBranchName{"AtRawEvent"};
+   TString fFilteredEventBranchName{"AtRawEventFiltered"};
+   TString fEventBranchName{"AtEventH"};
+   TString fPatternEventBranchName{"AtPatternEvent"};
+
+   Bool_t fIsRawEventPersistent{false};
+   Bool_t fIsFilteredEventPersistent{false};
+   Bool_t fIsEventPersistent{true};
+   Bool_t fIsPatternEventPersistent{true};
+   Bool_t fFilterAux{false};
+
+   Int_t fNumThreads{1};
+   Int_t fBatchSize{0}; //< Number of events unpacked per batch (defaults to 4 per thread)
+   Int_t fMinNumHits{10};
+   Int_t fMaxNumHits{5000};
+
+   TClonesArray fRawEventArray;
+   TClonesArray fFilteredEventArray;
+   TClonesArray fEventArray;
+   TClonesArray fPatternEventArray;
+
+   std::unique_ptr<AtUnpacker> fUnpacker;  //!
+   std::unique_ptr<AtFilter> fFilter;      //!
+   std::unique_ptr<AtPSA> fPSA;            //!
+   std::unique_ptr<AtPATTERN::AtPRA> fPRA; //!
+
+   std::vector<Worker> fWorkers;                   //!
+   std::vector<std::unique_ptr<EventSlot>> fSlots; //!
+   std::atomic<Int_t> fNextSlotToProcess{0};       //!
+   Int_t fNumSlotsFilled{0};
+   Int_t fNextSlotToWrite{0};
+   Bool_t fFinishedUnpacking{false};
+
+public:
+   AtParallelRecoTask(std::unique_ptr<AtUnpacker> unpacker, std::unique_ptr<AtPSA> psa);
+   ~AtParallelRecoTask();
+
+   /// Filter to apply to the unpacked event before the PSA. If not set the raw event is passed to the PSA.
+   void SetFilter(std::unique_ptr<AtFilter> filter) { fFilter = std::move(filter); }
+   /// Pattern recognition to run on the PSA output. If not set no pattern event is produced.
+   void SetPRA(std::unique_ptr<AtPATTERN::AtPRA> pra) { fPRA = std::move(pra); }
+
+   void SetNumThreads(Int_t numThreads) { fNumThreads = numThreads; }
+   void SetBatchSize(Int_t batchSize) { fBatchSize = batchSize; }
+   void SetFilterAux(Bool_t value) { fFilterAux = value; }
+   void SetMinNumHits(Int_t minHits) { fMinNumHits = minHits; }
+   void SetMaxNumHits(Int_t maxHits) { fMaxNumHits = maxHits; }
+
+   void SetRawEventBranch(TString name) { fRawEventBranchName = name; }
+   void SetFilteredEventBranch(TString name) { fFilteredEventBranchName = name; }
+   void SetEventBranch(TString name) { fEventBranchName = name; }
+   void SetPatternEventBranch(TString name) { fPatternEventBranchName = name; }
+
+   void SetRawEventPersistence(Bool_t value) { fIsRawEventPersistent = value; }
+   void SetFilteredEventPersistence(Bool_t value) { fIsFilteredEventPersistent = value; }
+   void SetEventPersistence(Bool_t value) { fIsEventPersistent = value; }
+   void SetPatternEventPersistence(Bool_t value) { fIsPatternEventPersistent = value; }
+
+   Long64_t GetNumEvents() { return fUnpacker->GetNumEvents(); }
+
+   virtual InitStatus Init() override;
+   virtual void Exec(Option_t *opt) override;
+   virtual void FinishEvent() override;
+
+private:
+   void FillAndProcessBatch();
+   void ProcessSlots(Worker &worker);
+   void ProcessEvent(Worker &worker, EventSlot &slot);
+   void WriteSlot(EventSlot &slot);
+
+   ClassDefOverride(AtParallelRecoTask, 1);
+};
+
+#endif //#ifndef ATPARALLELRECOTASK_H
@@ -1,22 +1,20 @@
 #include "AtEstimatorMethods.h"
 
 #include "AtContainerManip.h"
-#include "AtHit.h" // for AtHit
 #include "AtPattern.h"
 
 #include <algorithm> // for max_element, nth_element, max
 #include <cmath>     // for exp, sqrt, isinf, log, M_PI
+#include <cstddef>   // for size_t
 using namespace SampleConsensus;
 
-int SampleConsensus::EvaluateChi2(AtPatterns::AtPattern *model, const std::vector<AtHit> &hitArray,
+int SampleConsensus::EvaluateChi2(AtPatterns::AtPattern *model, const std::vector<double> &distances,
                                   double distanceThreshold)
 {
    int nbInliers = 0;
    double weight = 0;
 
-   for (const auto &hit : hitArray) {
-      auto &pos = hit.GetPosition();
-      double error = model->DistanceToPattern(pos);
+   for (auto error : distances) {
       error = error * error;
       if (error < (distanceThreshold * distanceThreshold)) {
          nbInliers++;
@@ -26,13 +24,11 @@ int SampleConsensus::EvaluateChi2(AtPatterns::AtPattern *model, const std::vecto
    model->SetChi2(weight / nbInliers);
    return nbInliers;
 }
-int SampleConsensus::EvaluateRansac(AtPatterns::AtPattern *model, const std::vector<AtHit> &hitArray,
+int SampleConsensus::EvaluateRansac(AtPatterns::AtPattern *model, const std::vector<double> &distances,
                                     double distanceThreshold)
 {
    int nbInliers = 0;
-   for (const auto &hit : hitArray) {
-      auto &pos = hit.GetPosition();
-      double error = model->DistanceToPattern(pos);
+   for (auto error : distances) {
       error = error * error;
       if (error < (distanceThreshold * distanceThreshold)) {
          nbInliers++;
@@ -42,7 +38,7 @@ int SampleConsensus::EvaluateRansac(AtPatterns::AtPattern *model, const std::vec
    return nbInliers;
 }
 
-int SampleConsensus::EvaluateMlesac(AtPatterns::AtPattern *model, const std::vector<AtHit> &hitArray,
+int SampleConsensus::EvaluateMlesac(AtPatterns::AtPattern *model, const std::vector<double> &distances,
                                     double distanceThreshold)
 {
    double sigma = distanceThreshold / 1.96;
@@ -50,8 +46,7 @@ int SampleConsensus::EvaluateMlesac(AtPatterns::AtPattern *model, const std::vec
 
    // Calculate min and max errors
    double minError = 1e5, maxError = -1e5;
-   for (const auto &hit : hitArray) {
-      double error = model->DistanceToPattern(hit.GetPosition());
+   for (auto error : distances) {
       if (error < minError)
          minError = error;
       if (error > maxError)
@@ -66,12 +61,11 @@ int SampleConsensus::EvaluateMlesac(AtPatterns::AtPattern *model, const std::vec
       const double probOutlier = (1 - gamma) / nu;
       const double probInlierCoeff = gamma / sqrt(2 * M_PI * dataSigma2);
 
-      for (const auto &hit : hitArray) {
-         double error = model->DistanceToPattern(hit.GetPosition());
+      for (auto error : distances) {
          double probInlier = probInlierCoeff * exp(-0.5 * error * error / dataSigma2);
          sumPosteriorProb += probInlier / (probInlier + probOutlier);
       }
-      gamma = sumPosteriorProb / hitArray.size();
+      gamma = sumPosteriorProb / distances.size();
    }
 
    double sumLogLikelihood = 0;
@@ -80,8 +74,7 @@ int SampleConsensus::EvaluateMlesac(AtPatterns::AtPattern *model, const std::vec
    // Evaluate the model
    const double probOutlier = (1 - gamma) / nu;
    const double probInlierCoeff = gamma / sqrt(2 * M_PI * dataSigma2);
-   for (const auto &hit : hitArray) {
-      double error = model->DistanceToPattern(hit.GetPosition());
+   for (auto error : distances) {
       double probInlier = probInlierCoeff * exp(-0.5 * error * error / dataSigma2);
       // if((probInlier + probOutlier)>0) sumLogLikelihood = sumLogLikelihood - log(probInlier + probOutlier);
 
@@ -100,14 +93,12 @@ int SampleConsensus::EvaluateMlesac(AtPatterns::AtPattern *model, const std::vec
    return nbInliers;
 }
 
-int SampleConsensus::EvaluateLmeds(AtPatterns::AtPattern *model, const std::vector<AtHit> &hitArray,
+int SampleConsensus::EvaluateLmeds(AtPatterns::AtPattern *model, const std::vector<double> &distances,
                                    double distanceThreshold)
 {
    std::vector<double> errorsVec;
    // Loop through point and if it is an inlier, then add the error**2 to weight
-   for (const auto &hit : hitArray) {
-
-      double error = model->DistanceToPattern(hit.GetPosition());
+   for (auto error : distances) {
       error = error * error;
       if (error < (distanceThreshold * distanceThreshold))
          errorsVec.push_back(error);
@@ -116,21 +107,19 @@ int SampleConsensus::EvaluateLmeds(AtPatterns::AtPattern *model, const std::vect
    return errorsVec.size();
 }
 
-int SampleConsensus::EvaluateWeightedRansac(AtPatterns::AtPattern *model, const std::vector<AtHit> &hitArray,
-                                            double distanceThreshold)
+int SampleConsensus::EvaluateWeightedRansac(AtPatterns::AtPattern *model, const std::vector<double> &distances,
+                                            const std::vector<double> &charge, double distanceThreshold)
 {
    int nbInliers = 0;
    double totalCharge = 0;
    double weight = 0;
 
-   for (const auto &hit : hitArray) {
-      auto &pos = hit.GetPosition();
-      double error = model->DistanceToPattern(pos);
-      error = error * error;
+   for (std::size_t i = 0; i < distances.size(); ++i) {
+      double error = distances[i] * distances[i];
       if (error < (distanceThreshold * distanceThreshold)) {
          nbInliers++;
-         totalCharge += hit.GetCharge();
-         weight += error * hit.GetCharge();
+         totalCharge += charge[i];
+         weight += error * charge[i];
       }
    }
    model->SetChi2(weight / totalCharge);
@@ -2,7 +2,6 @@
 #define ATESTIMATORMETHODS_H
 
 #include <vector>
-class AtHit;
 namespace AtPatterns {
 class AtPattern;
 }
@@ -11,7 +10,8 @@ namespace SampleConsensus {
 /**
  * @brief Estimators for AtSampleConsensus.
  *
- * All implemented estimators for AtSampleConsensus.
+ * All implemented estimators for AtSampleConsensus. Each estimator is passed the distance of every hit to the
+ * model (see AtPatterns::AtPattern::DistancesToPattern), so the distances are only calculated once per model.
  * @ingroup SampleConsensus
  */
 enum class Estimators { kRANSAC, kLMedS, kMLESAC, kWRANSAC, kChi2 };
@@ -20,26 +20,27 @@ enum class Estimators { kRANSAC, kLMedS, kMLESAC, kWRANSAC, kChi2 };
  *
  * Maximizes the number of inliers.
  */
-int EvaluateRansac(AtPatterns::AtPattern *model, const std::vector<AtHit> &hitArray, double distanceThreshold);
+int EvaluateRansac(AtPatterns::AtPattern *model, const std::vector<double> &distances, double distanceThreshold);
 /**
  * @brief Implementation of estimator that minimizes chi2.
  *
  * Used to minimize avg(error^2) for all inliers.
  */
-int EvaluateChi2(AtPatterns::AtPattern *model, const std::vector<AtHit> &hitArray, double distanceThreshold);
+int EvaluateChi2(AtPatterns::AtPattern *model, const std::vector<double> &distances, double distanceThreshold);
 
 /**
  * @brief Implementation of MLESAC estimator
  */
-int EvaluateMlesac(AtPatterns::AtPattern *model, const std::vector<AtHit> &hitArray, double distanceThreshold);
+int EvaluateMlesac(AtPatterns::AtPattern *model, const std::vector<double> &distances, double distanceThreshold);
 /**
  * @brief Implementation of LMedS estimator
  */
-int EvaluateLmeds(AtPatterns::AtPattern *model, const std::vector<AtHit> &hitArray, double distanceThreshold);
+int EvaluateLmeds(AtPatterns::AtPattern *model, const std::vector<double> &distances, double distanceThreshold);
 /**
  * @brief Implementation of RANSAC estimator using charge weighting
  */
-int EvaluateWeightedRansac(AtPatterns::AtPattern *model, const std::vector<AtHit> &hitArray, double distanceThreshold);
+int EvaluateWeightedRansac(AtPatterns::AtPattern *model, const std::vector<double> &distances,
+                           const std::vector<double> &charge, double distanceThreshold);
 
 } // namespace SampleConsensus
 #endif //#ifndef ATESTIMATORMETHODS_H
@@ -8,6 +8,7 @@
 #include "AtPatternLine.h"
 #include "AtPatternTypes.h" // for PatternType, PatternTy...
 #include "AtSampleConsensus.h"
+#include "AtSpatialIndex.h"
 #include "AtTrack.h" // for XYZPoint, AtTrack
 
 #include <FairLogger.h>
@@ -16,14 +17,15 @@
 #include <Math/Vector2D.h>    // for PositionVector3D, Cart...
 #include <Math/Vector2Dfwd.h> // for XYVector
 #include <Math/Vector3D.h>    // for DisplacementVector3D
-#include <TF1.h>              // for TF1
-#include <TGraph.h>           // for TGraph
 #include <TMath.h>            // for Power, Sqrt, ATan2, Pi
 #include <TMatrixDSymfwd.h>   // for TMatrixDSym
 #include <TMatrixTSym.h>      // for TMatrixTSym
+#include <TRandom.h>          // for TRandom, gRandom
+#include <TRandom3.h>         // for TRandom3
 #include <TVector3.h>         // for TVector3
 
-#include <algorithm>          // for max, for_each, copy_if
+#include <algorithm>          // for max, min, for_each, copy_if
+#include <atomic>             // for atomic
 #include <cmath>              // for fabs, acos
 #include <cstddef>            // for size_t
 #include <exception>          // for exception
@@ -31,15 +33,27 @@
 #include <iostream>           // for operator<<, basic_ostream
 #include <iterator>           // for back_insert_iterator
 #include <memory>             // for shared_ptr, __shared_p...
+#include <thread>             // for thread
+#include <utility>            // for move
 
 ClassImp(AtPATTERN::AtPRA);
 
+AtPATTERN::AtPRA::AtPRA(const AtPRA &other)
+   : TObject(other), fTrackCand(other.fTrackCand), fPar(other.fPar), fMaxHits(other.fMaxHits),
+     fMinHits(other.fMinHits), fMeanDistance(other.fMeanDistance), fKNN(other.fKNN),
+     fStdDevMulkNN(other.fStdDevMulkNN), fkNNDist(other.fkNNDist), kSetPrunning(other.kSetPrunning),
+     fTrackTransformer(std::make_unique<AtTools::AtTrackTransformer>(*other.fTrackTransformer)),
+     fClusterRadius(other.fClusterRadius), fClusterDistance(other.fClusterDistance), fNumThreads(other.fNumThreads),
+     fConfidence(other.fConfidence), fEventSeed(other.fEventSeed)
+{
+}
+
 /**
  * @brief Set initial parameters for HC.
  *
  * In track, sets GeoTheta, GeoPhi, GeoCenter, GeoRadius.
  */
-void AtPATTERN::AtPRA::SetTrackInitialParameters(AtTrack &track)
+void AtPATTERN::AtPRA::SetTrackInitialParameters(AtTrack &track, TRandom *random)
 {
 
    /*
@@ -55,6 +69,8 @@ std::cout << " Processing track with " << track.GetHitArray().size() << " points
    RansacSmoothRadius.SetMinHitsPattern(0.1 * track.GetHitArray().size());
    RansacSmoothRadius.SetDistanceThreshold(6.0);
    RansacSmoothRadius.SetNumIterations(1000);
+   RansacSmoothRadius.SetConfidence(fConfidence);
+   RansacSmoothRadius.SetRandom(random);
    circularTracks =
       RansacSmoothRadius.Solve(track.GetHitArray()).GetTrackCand(); // Only part of the spiral is used
                                                                     // This function also sets the coefficients
@@ -77,8 +93,6 @@ std::cout << " Processing track with " << track.GetHitArray().size() << " points
       std::vector<double> whit;
       std::vector<double> arclength;
 
-      auto arclengthGraph = std::make_unique<TGraph>();
-
       auto posPCA = hits.at(0).GetPosition();
       auto refPosOnCircle = posPCA - center;
       auto refAng = refPosOnCircle.Phi(); // Bounded between (-Pi,Pi]
@@ -112,8 +126,6 @@ std::cout << " Processing track with " << track.GetHitArray().size() << " points
          whit.push_back(angleHit);
          arclength.push_back((radius * (refAng - whit.at(i))));
 
-         arclengthGraph->SetPoint(arclengthGraph->GetN(), arclength.at(i), pos.Z());
-
          if (track.GetTrackID() > -1)
             LOG(debug2) << posOnCircle.X() << "  " << posOnCircle.Y() << " " << pos.Z() << " "
                         << hits.at(i).GetTimeStamp() << " " << arclength.back() << "\n";
@@ -126,14 +138,6 @@ std::cout << " Processing track with " << track.GetHitArray().size() << " points
          thetaHits.emplace_back(i, hits.at(i).GetPadNum(), XYZPoint(xPos, yPos, zPos), hits.at(i).GetCharge());
       }
 
-      // TF1 *f1 = new TF1("f1", "pol1", -500, 500);
-      // TF1 * f1 = new TF1("f1",[](double *x, double *p) { return (p[0]+p[1]*x[0]); },-500,500,2);
-      // TF1 * f1 = new TF1("f1","[0]+[1]*x",-500,500);
-      // TF1 *f1 = new TF1("f1", fitf, -500, 500, 2);
-      // arclengthGraph->Fit(f1, "R");
-      // auto slope = ROOT::Math::XYVector(1, f1->GetParameter(1)).Unit();
-      // std::cout << " Slope " << slope << "\n";
-
       Double_t angle = 0.0;
       Double_t phi0 = 0.0;
 
@@ -148,6 +152,8 @@ std::cout << " Processing track with " << track.GetHitArray().size() << " points
             RansacTheta.SetMinHitsPattern(0.1 * thetaHits.size());
             RansacTheta.SetDistanceThreshold(6.0);
             RansacTheta.SetFitPattern(true);
+            RansacTheta.SetConfidence(fConfidence);
+            RansacTheta.SetRandom(random);
             thetaTracks = RansacTheta.Solve(thetaHits).GetTrackCand();
 
             if (thetaTracks.size() > 0) {
@@ -201,6 +207,43 @@ std::cout << " Processing track with " << track.GetHitArray().size() << " points
    } // end if (!circularTracks->empty())
 }
 
+/**
+ * @brief Set initial parameters for every track of an event, split over fNumThreads threads.
+ *
+ * Each track is sampled with its own generator, seeded before any track is processed from the generator
+ * seeded with fEventSeed (or gRandom if it is 0). The result is then reproducible, and independent of the
+ * number of threads and which thread handles which track. Tracks without hits are skipped.
+ */
+void AtPATTERN::AtPRA::SetTracksInitialParameters(std::vector<AtTrack> &tracks)
+{
+   TRandom3 eventRandom(fEventSeed);
+   TRandom *seedRandom = fEventSeed != 0 ? &eventRandom : gRandom;
+
+   std::vector<UInt_t> seeds;
+   seeds.reserve(tracks.size());
+   for (std::size_t i = 0; i < tracks.size(); ++i)
+      seeds.push_back(seedRandom->Integer(kMaxUInt) + 1); // 0 would seed TRandom3 from the time
+
+   // Threads take the next unprocessed track, so the event takes about as long as its longest track
+   std::atomic<std::size_t> nextTrack{0};
+   auto processTracks = [this, &tracks, &seeds, &nextTrack]() {
+      for (auto i = nextTrack++; i < tracks.size(); i = nextTrack++) {
+         if (tracks[i].GetHitArray().empty())
+            continue;
+         TRandom3 random(seeds[i]);
+         SetTrackInitialParameters(tracks[i], &random);
+      }
+   };
+
+   auto numThreads = std::max<std::size_t>(1, std::min<std::size_t>(fNumThreads, tracks.size()));
+   std::vector<std::thread> threads;
+   for (std::size_t i = 1; i < numThreads; ++i)
+      threads.emplace_back(processTracks);
+   processTracks();
+   for (auto &thread : threads)
+      thread.join();
+}
+
 Double_t fitf(Double_t *x, Double_t *par)
 {
 
@@ -209,50 +252,57 @@ Double_t fitf(Double_t *x, Double_t *par)
 
 void AtPATTERN::AtPRA::PruneTrack(AtTrack &track)
 {
-   std::vector<AtHit> hitArray = track.GetHitArray();
+   auto &hitArray = track.GetHitArray();
 
    std::cout << "    === Prunning track : " << track.GetTrackID() << "\n";
    std::cout << "      = Hit Array size : " << hitArray.size() << "\n";
 
+   // Every hit is tested against the full track, using an index built once for the track
+   AtTools::AtSpatialIndex index(hitArray);
+   std::vector<bool> isNoise(hitArray.size(), false);
    for (auto iHit = 0; iHit < hitArray.size(); ++iHit) {
 
       try {
-         bool isNoise = kNN(hitArray, hitArray.at(iHit), fKNN); // Returns true if hit is an outlier
-
-         if (isNoise) {
-            // std::cout<<" Hit "<<iHit<<" flagged as outlier. "<<"\n";
-            hitArray.erase(hitArray.begin() + iHit);
-         }
+         isNoise[iHit] = kNN(index, hitArray.at(iHit), fKNN); // Returns true if hit is an outlier
       } catch (std::exception &e) {
 
          std::cout << " AtPRA::PruneTrack - Exception caught : " << e.what() << "\n";
       }
    }
 
+   std::vector<AtHit> prunedHits;
+   prunedHits.reserve(hitArray.size());
+   for (auto iHit = 0; iHit < hitArray.size(); ++iHit)
+      if (!isNoise[iHit])
+         prunedHits.push_back(std::move(hitArray[iHit]));
+   hitArray = std::move(prunedHits);
+
    std::cout << "      = Hit Array size after prunning : " << hitArray.size() << "\n";
 }
 
 bool AtPATTERN::AtPRA::kNN(const std::vector<AtHit> &hits, AtHit &hitRef, int k)
 {
+   return kNN(AtTools::AtSpatialIndex(hits), hitRef, k);
+}
 
-   std::vector<Double_t> distances;
-   distances.reserve(hits.size());
-
-   std::for_each(hits.begin(), hits.end(), [&distances, &hitRef](const AtHit &hit) {
-      distances.push_back(TMath::Sqrt((hitRef.GetPosition() - hit.GetPosition()).Mag2()));
-   });
+bool AtPATTERN::AtPRA::kNN(const AtTools::AtSpatialIndex &index, const AtHit &hitRef, int k)
+{
+   if (k > index.size())
+      k = index.size();
+   if (k <= 0)
+      return false;
 
-   std::sort(distances.begin(), distances.end(), [](Double_t a, Double_t b) { return a < b; });
+   std::vector<Double_t> distances;
+   index.GetKNearest(hitRef.GetPosition(), k, &distances); // Squared distances, closest first
 
    Double_t mean = 0.0;
    Double_t stdDev = 0.0;
 
-   if (k > hits.size())
-      k = hits.size();
-
    // Compute mean distance of kNN
-   for (auto i = 0; i < k; ++i)
-      mean += distances.at(i);
+   for (auto &dist : distances) {
+      dist = TMath::Sqrt(dist);
+      mean += dist;
+   }
 
    mean /= k;
 
@@ -19,6 +19,10 @@ class AtPatternEvent;
 class TBuffer;
 class TClass;
 class TMemberInspector;
+class TRandom;
+namespace AtTools {
+class AtSpatialIndex;
+}
 
 namespace AtPATTERN {
 
@@ -48,9 +52,18 @@ protected:
    Double_t fClusterRadius{0};   //<! Radius of hit clusters
    Double_t fClusterDistance{0}; //<! Distance between hit clusters
 
+   Int_t fNumThreads{1};    //<! Number of threads to use within an event
+   Double_t fConfidence{0}; //<! Confidence to stop the RANSAC fits of the initial parameters early (0 = never)
+   UInt_t fEventSeed{0};    //<! Seed of the track generators of the next event (0 = draw from gRandom)
+
 public:
+   AtPRA() = default;
+   AtPRA(const AtPRA &other);
    virtual ~AtPRA() = default;
 
+   /// Create a copy of this pattern recognition algorithm with the same parameters
+   virtual std::unique_ptr<AtPRA> Clone() = 0;
+
    // Getters
    virtual std::vector<AtTrack> GetTrackCand() const { return fTrackCand; }
 
@@ -64,11 +77,24 @@ public:
    void SetPrunning() { kSetPrunning = kTRUE; }
    void SetClusterRadius(Double_t clusterRadius) { fClusterRadius = clusterRadius; }
    void SetClusterDistance(Double_t clusterDistance) { fClusterDistance = clusterDistance; }
+   /// Number of threads to use within an event. Requires ROOT::EnableThreadSafety().
+   void SetNumThreads(Int_t numThreads) { fNumThreads = numThreads; }
+   /**
+    * Stop the RANSAC fits used for the initial track parameters once this confidence is reached (see
+    * AtSampleConsensus::SetConfidence). Faster, but can select a different circle or line than a full run.
+    */
+   void SetConfidence(Double_t confidence) { fConfidence = confidence; }
+   /**
+    * Seed the random sampling of the next events with seed instead of gRandom, which is not safe to use when
+    * events are processed on several threads at once (see AtParallelRecoTask). 0 goes back to gRandom.
+    */
+   void SetEventSeed(UInt_t seed) { fEventSeed = seed; }
 
    virtual std::unique_ptr<AtPatternEvent> FindTracks(AtEvent &event) = 0;
 
    void PruneTrack(AtTrack &track);
    bool kNN(const std::vector<AtHit> &hits, AtHit &hit, int k);
+   bool kNN(const AtTools::AtSpatialIndex &index, const AtHit &hit, int k);
 
 protected:
    // Functions that need to be moved to another class. They assume a curved track
@@ -77,8 +103,11 @@ protected:
     * as initial guesses for GenFit. Probably, this should be moved into the fitting classes instead of
     * here. At the very least, it needs to be in a subclass that only deals with curved tracks, it
     * would make no sense to apply this function to straight tracks.
+    *
+    * Samples with random if it is not null, otherwise with gRandom.
     */
-   void SetTrackInitialParameters(AtTrack &track);
+   void SetTrackInitialParameters(AtTrack &track, TRandom *random = nullptr);
+   void SetTracksInitialParameters(std::vector<AtTrack> &tracks);
 
    template <typename T>
    inline constexpr int GetSign(T num, std::true_type is_signed)
@@ -96,7 +125,7 @@ protected:
       return GetSign(num, std::is_signed<T>());
    }
 
-   ClassDef(AtPRA, 1)
+   ClassDef(AtPRA, 4)
 };
 
 } // namespace AtPATTERN
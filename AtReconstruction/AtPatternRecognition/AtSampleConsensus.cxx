@@ -12,10 +12,13 @@
 #include <FairLogger.h> // for Logger, LOG
 
 #include <algorithm> // for max
+#include <cmath>     // for log, pow, ceil
 #include <fstream>   // for std
 #include <iterator>  // for insert_iterator, inserter
+#include <limits>    // for numeric_limits
 #include <memory>    // for allocator_traits<>::value_type
-#include <set>       // for set, operator!=, _Rb_tree_const_iterator
+#include <numeric>   // for iota
+#include <thread>    // for thread
 
 using namespace SampleConsensus;
 
@@ -30,30 +33,69 @@ AtSampleConsensus::AtSampleConsensus(Estimators estimator, PatternType patternTy
 {
 }
 
-std::unique_ptr<AtPatterns::AtPattern> AtSampleConsensus::GeneratePatternFromHits(const std::vector<AtHit> &hitArray)
+/**
+ * Evaluate every pattern in parallel, returning the number of inliers of each pattern (0 if it failed the
+ * preemptive test).
+ */
+std::vector<int> AtSampleConsensus::EvaluatePatterns(const std::vector<PatternPtr> &patterns, const AtHitBuffer &hits,
+                                                     const AtHitBuffer &preemptiveHits) const
 {
+   std::vector<int> nInliers(patterns.size());
+   auto evaluateRange = [&](std::size_t begin, std::size_t end) {
+      std::vector<double> distances;
+      for (auto i = begin; i < end; ++i)
+         nInliers[i] = EvaluatePattern(patterns[i].get(), hits, preemptiveHits, distances);
+   };
+
+   auto numThreads = std::max<std::size_t>(1, std::min<std::size_t>(fNumThreads, patterns.size()));
+   auto patternsPerThread = (patterns.size() + numThreads - 1) / numThreads;
+   std::vector<std::thread> threads;
+   for (std::size_t i = 1; i < numThreads; ++i)
+      threads.emplace_back(evaluateRange, std::min(patterns.size(), i * patternsPerThread),
+                           std::min(patterns.size(), (i + 1) * patternsPerThread));
+   evaluateRange(0, std::min(patterns.size(), patternsPerThread));
+   for (auto &thread : threads)
+      thread.join();
+
+   return nInliers;
+}
 
-   if (hitArray.size() < fMinPatternPoints) {
-      return nullptr;
+int AtSampleConsensus::EvaluatePattern(AtPattern *pattern, const AtHitBuffer &hits, const AtHitBuffer &preemptiveHits,
+                                       std::vector<double> &distances) const
+{
+   if (!preemptiveHits.empty()) {
+      distances.resize(preemptiveHits.size());
+      pattern->DistancesToPattern(preemptiveHits.fX.data(), preemptiveHits.fY.data(), preemptiveHits.fZ.data(),
+                                  preemptiveHits.size(), distances.data());
+      int nInliers = 0;
+      for (auto error : distances)
+         if (error * error < fDistanceThreshold * fDistanceThreshold)
+            nInliers++;
+
+      // Compare to half the inliers a pattern with fMinPatternPoints inliers should have in the test hits
+      if (2 * nInliers * hits.size() < fMinPatternPoints * preemptiveHits.size()) {
+         LOG(debug) << "Rejecting pattern with " << nInliers << " inliers in preemptive test";
+         return 0;
+      }
    }
 
-   auto pattern = AtPatterns::CreatePattern(fPatternType);
-
-   auto points = fRandSampler->SamplePoints(pattern->GetNumPoints());
-
-   pattern->DefinePattern(points);
-
    LOG(debug) << "Testing pattern" << std::endl;
-   auto nInliers = SampleConsensus::AtEstimator::EvaluateModel(pattern.get(), hitArray, fDistanceThreshold, fEstimator);
+   auto nInliers = AtEstimator::EvaluateModel(pattern, hits, fDistanceThreshold, fEstimator, distances);
    LOG(debug) << "Found " << nInliers << " inliers";
+   return nInliers;
+}
 
-   // If the pattern is consistent with enough points, save it
-   if (nInliers > fMinPatternPoints) {
-      LOG(debug) << "Adding pattern with nInliers: " << nInliers;
-      return pattern;
-   }
-
-   return nullptr;
+/**
+ * Number of patterns that must be sampled to have sampled one from only inliers with probability fConfidence.
+ */
+int AtSampleConsensus::RequiredIterations(int nInliers, int nHits, int nPoints) const
+{
+   double probAllInliers = std::pow(static_cast<double>(nInliers) / nHits, nPoints);
+   if (probAllInliers <= 0)
+      return std::numeric_limits<int>::max();
+   if (probAllInliers >= 1)
+      return 1;
+   return std::ceil(std::log(1 - fConfidence) / std::log(1 - probAllInliers));
 }
 
 AtPatternEvent AtSampleConsensus::Solve(AtEvent *event)
@@ -76,95 +118,122 @@ AtPatternEvent AtSampleConsensus::Solve(const std::vector<AtHit> &hitArray)
          return {};
          }*/
 
-   auto comp = [](const PatternPtr &a, const PatternPtr &b) { return a->GetChi2() < b->GetChi2(); };
-   auto sortedPatterns = std::set<PatternPtr, decltype(comp)>(comp);
-
-   LOG(debug2) << "Generating " << fIterations << " patterns";
+   // Patterns are always sampled on this thread, so the result does not depend on the number of threads
    fRandSampler->SetHitsToSample(&hitArray);
-   for (int i = 0; i < fIterations; i++) {
-      auto pattern = GeneratePatternFromHits(hitArray);
-      if (pattern != nullptr)
-         sortedPatterns.insert(std::move(pattern));
+   fRandSampler->SetRandom(fRandom);
+   auto numPoints = AtPatterns::CreatePattern(fPatternType)->GetNumPoints();
+
+   AtHitBuffer hits(hitArray);
+   AtHitBuffer preemptiveHits;
+   if (fPreemptiveHits > 0 && fPreemptiveHits < hitArray.size()) {
+      std::vector<AtHit> testHits;
+      double stride = static_cast<double>(hitArray.size()) / fPreemptiveHits;
+      for (int i = 0; i < fPreemptiveHits; ++i)
+         testHits.push_back(hitArray[static_cast<std::size_t>(i * stride)]);
+      preemptiveHits.Fill(testHits);
    }
-   LOG(debug2) << "Created " << sortedPatterns.size() << " valid patterns.";
 
-   // Loop through each pattern, and extract the points that fit each pattern
-   auto remainHits = hitArray;
+   LOG(debug2) << "Generating up to " << fIterations << " patterns";
+   std::vector<PatternPtr> patterns;
+   std::vector<PatternPtr> batch;
+   int bestInliers = 0;
+   for (int i = 0; i < fIterations;) {
+      batch.clear();
+      for (; batch.size() < fBatchSize && i < fIterations; ++i) {
+         auto pattern = AtPatterns::CreatePattern(fPatternType);
+         pattern->DefinePattern(fRandSampler->SamplePoints(pattern->GetNumPoints()));
+         batch.push_back(std::move(pattern));
+      }
+
+      auto nInliers = EvaluatePatterns(batch, hits, preemptiveHits);
+      for (std::size_t j = 0; j < batch.size(); ++j) {
+         bestInliers = std::max(bestInliers, nInliers[j]);
+
+         // If the pattern is consistent with enough points, save it
+         if (nInliers[j] > fMinPatternPoints) {
+            LOG(debug) << "Adding pattern with nInliers: " << nInliers[j];
+            patterns.push_back(std::move(batch[j]));
+         }
+      }
+
+      if (fConfidence > 0 && i >= RequiredIterations(bestInliers, hitArray.size(), numPoints)) {
+         LOG(debug2) << "Reached confidence " << fConfidence << " after " << i << " patterns";
+         break;
+      }
+   }
+
+   // Sort by chi2, keeping only the first pattern found for each chi2
+   auto comp = [](const PatternPtr &a, const PatternPtr &b) { return a->GetChi2() < b->GetChi2(); };
+   auto equal = [](const PatternPtr &a, const PatternPtr &b) { return a->GetChi2() == b->GetChi2(); };
+   std::stable_sort(patterns.begin(), patterns.end(), comp);
+   patterns.erase(std::unique(patterns.begin(), patterns.end(), equal), patterns.end());
+   LOG(debug2) << "Created " << patterns.size() << " valid patterns.";
+
+   // Loop through each pattern, and extract the points that fit each pattern. The remaining hits are kept as
+   // indices into hitArray, so each hit is copied only once: into its track or into the noise.
+   std::vector<std::size_t> remainHits(hitArray.size());
+   std::iota(remainHits.begin(), remainHits.end(), 0);
    AtPatternEvent retEvent;
-   for (const auto &pattern : sortedPatterns) {
+   for (const auto &pattern : patterns) {
       if (remainHits.size() < fMinPatternPoints)
          break;
 
-      auto inlierHits = movePointsInPattern(pattern.get(), remainHits);
+      auto inlierHits = movePointsInPattern(pattern.get(), hitArray, remainHits);
       if (inlierHits.size() > fMinPatternPoints) {
-         auto track = CreateTrack(pattern.get(), inlierHits);
+         auto track = CreateTrack(pattern.get(), hitArray, inlierHits);
          track.SetTrackID(retEvent.GetTrackCand().size());
-         retEvent.AddTrack(track);
+         retEvent.AddTrack(std::move(track));
       }
    }
 
    // Add the remaining hits as noise
-   for (auto &hit : remainHits)
-      retEvent.AddNoise(std::move(hit));
+   for (auto i : remainHits)
+      retEvent.AddNoise(hitArray[i]);
 
    return retEvent;
 }
 
-AtTrack AtSampleConsensus::CreateTrack(AtPattern *pattern, std::vector<AtHit> &inliers)
+AtTrack AtSampleConsensus::CreateTrack(AtPattern *pattern, const std::vector<AtHit> &hitArray,
+                                       const std::vector<std::size_t> &inliers)
 {
    AtTrack track;
 
    // Add inliers to our ouput track
-   for (auto &hit : inliers)
-      track.AddHit(std::move(hit));
+   track.GetHitArray().reserve(inliers.size());
+   for (auto i : inliers)
+      track.AddHit(hitArray[i]);
 
    if (fFitPattern)
-      pattern->FitPattern(inliers, fChargeThres);
+      pattern->FitPattern(track.GetHitArrayConst(), fChargeThres);
 
    track.SetPattern(pattern->Clone());
    return track;
 }
 /**
- * Moves the entries of hits that are consistent with the pattern to the returned vector
+ * Moves the indices of hits that are consistent with the pattern to the returned vector
  *
  * @param [in] pattern
- * @param[in/out] hits Hits returned are removed from this vector
- * @return vector containing the AtHits consistent with the pattern
+ * @param[in] hitArray Hits the indices refer to
+ * @param[in/out] indices Indices of the hits to check. Indices returned are removed from this vector
+ * @return vector containing the indices of the AtHits consistent with the pattern
  *
  */
-std::vector<AtHit> AtSampleConsensus::movePointsInPattern(AtPattern *pattern, std::vector<AtHit> &hits)
+std::vector<std::size_t> AtSampleConsensus::movePointsInPattern(AtPattern *pattern, const std::vector<AtHit> &hitArray,
+                                                               std::vector<std::size_t> &indices)
 {
+   std::vector<std::size_t> retVec;
+   auto itRemain = indices.begin();
 
-   std::vector<AtHit> retVec;
-   auto itStartEqualRange = hits.end();
-
-   for (auto it = hits.begin(); it != hits.end(); ++it) {
-
-      double error = pattern->DistanceToPattern(it->GetPosition());
+   for (auto i : indices) {
+      double error = pattern->DistanceToPattern(hitArray[i].GetPosition());
       auto isInPattern = (error * error) < (fDistanceThreshold * fDistanceThreshold);
 
-      // Start of sub-vector with hits in pattern
-      if (isInPattern && itStartEqualRange == hits.end()) {
-         itStartEqualRange = it;
-         continue;
-      }
-
-      // End of sub-vector with hits in pattern.
-      // Move hits in this range to retVec then delete the empty entries
-      if (itStartEqualRange != hits.end() && !isInPattern) {
-         retVec.insert(retVec.end(), std::make_move_iterator(itStartEqualRange), std::make_move_iterator(it));
-         hits.erase(itStartEqualRange, it);
-         it = itStartEqualRange;
-         itStartEqualRange = hits.end();
-         continue;
-      }
+      if (isInPattern)
+         retVec.push_back(i);
+      else
+         *itRemain++ = i;
    }
+   indices.erase(itRemain, indices.end());
 
-   // If the last chunk of the array was in the pattern, move it and delete empty entries
-   if (itStartEqualRange != hits.end()) {
-      auto it = hits.end();
-      retVec.insert(retVec.end(), std::make_move_iterator(itStartEqualRange), std::make_move_iterator(it));
-      hits.erase(itStartEqualRange, it);
-   }
    return retVec;
 }
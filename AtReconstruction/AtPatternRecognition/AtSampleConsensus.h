@@ -10,11 +10,13 @@
 #include "AtEstimatorMethods.h" // for Estimators
 #include "AtPattern.h"
 #include "AtPatternTypes.h"
-#include "AtSampleMethods.h" // for SampleMethod
-#include "AtTrack.h"         // for AtTrack
+#include "AtSampleEstimator.h" // for AtHitBuffer
+#include "AtSampleMethods.h"   // for SampleMethod
+#include "AtTrack.h"           // for AtTrack
 
 #include <Rtypes.h> // for Int_t, Float_t
 
+#include <cstddef> // for size_t
 #include <memory>  // for unique_ptr
 #include <utility> // for pair
 #include <vector>  // for vector
@@ -22,6 +24,7 @@
 class AtHit;
 class AtEvent;
 class AtPatternEvent;
+class TRandom;
 namespace RandomSample {
 class AtSample;
 }
@@ -51,14 +54,34 @@ private:
    using PatternPtr = std::unique_ptr<AtPattern>;
    using AtSamplePtr = std::unique_ptr<RandomSample::AtSample>;
 
-   PatternType fPatternType; //< Type of pattern to find
-   Estimators fEstimator;    //< Estimator to evaluate pattern
-   AtSamplePtr fRandSampler; //< Sampling Method (defaults to uniform)
+   PatternType fPatternType;  //< Type of pattern to find
+   Estimators fEstimator;     //< Estimator to evaluate pattern
+   AtSamplePtr fRandSampler;  //< Sampling Method (defaults to uniform)
+   TRandom *fRandom{nullptr}; //< Generator to sample with (not owned). Uses gRandom if null.
 
    float fIterations{500};       //< Number of interations of sample consensus
    float fMinPatternPoints{30};  //< Required number of points to form a pattern
    float fDistanceThreshold{15}; //< Distance a point must be from pattern to be an inlier
    bool fFitPattern{true};
+
+   int fNumThreads{1}; //< Number of threads to evaluate patterns with
+   int fBatchSize{64}; //< Number of patterns sampled and evaluated together
+   /**
+    * @brief Confidence required to stop sampling early.
+    *
+    * If between 0 and 1, stop sampling patterns once the probability of having sampled a pattern
+    * from only inliers of the best pattern found so far reaches this value. fIterations is then the
+    * maximum number of patterns sampled. If 0, always sample fIterations patterns.
+    */
+   double fConfidence{0};
+   /**
+    * @brief Number of hits in the preemptive test.
+    *
+    * If larger than 0, patterns are first tested against this many hits spread evenly through the
+    * hit array. Patterns with less than half the inliers expected for a pattern with fMinPatternPoints
+    * inliers are rejected without being evaluated against every hit.
+    */
+   int fPreemptiveHits{0};
    /**
     * @brief Min charge for charge weighted fit.
     *
@@ -75,6 +98,8 @@ public:
    AtPatternEvent Solve(const std::vector<AtHit> &hitArray);
 
    void SetRandomSample(AtSamplePtr mode) { fRandSampler = std::move(mode); };
+   /// Sample patterns using **rand** instead of gRandom. Required to solve on several threads at once.
+   void SetRandom(TRandom *rand) { fRandom = rand; }
    void SetPatternType(PatternType type) { fPatternType = type; }
    void SetEstimator(Estimators estimator) { fEstimator = estimator; }
 
@@ -83,12 +108,21 @@ public:
    void SetDistanceThreshold(Float_t threshold) { fDistanceThreshold = threshold; };
    void SetChargeThreshold(double value) { fChargeThres = value; };
    void SetFitPattern(bool val) { fFitPattern = val; }
+   void SetNumThreads(int numThreads) { fNumThreads = numThreads; }
+   void SetBatchSize(int size) { fBatchSize = size; }
+   void SetConfidence(double confidence) { fConfidence = confidence; }
+   void SetPreemptiveHits(int nHits) { fPreemptiveHits = nHits; }
 
 private:
-   PatternPtr GeneratePatternFromHits(const std::vector<AtHit> &hitArray);
-   std::vector<AtHit> movePointsInPattern(AtPattern *pattern, std::vector<AtHit> &indexes);
+   std::vector<int> EvaluatePatterns(const std::vector<PatternPtr> &patterns, const AtHitBuffer &hits,
+                                     const AtHitBuffer &preemptiveHits) const;
+   int EvaluatePattern(AtPattern *pattern, const AtHitBuffer &hits, const AtHitBuffer &preemptiveHits,
+                       std::vector<double> &distances) const;
+   int RequiredIterations(int nInliers, int nHits, int nPoints) const;
+   std::vector<std::size_t>
+   movePointsInPattern(AtPattern *pattern, const std::vector<AtHit> &hitArray, std::vector<std::size_t> &indices);
    // void SaveTrack(AtPattern *pattern, std::vector<AtHit> &indexes, AtPatternEvent *event);
-   AtTrack CreateTrack(AtPattern *pattern, std::vector<AtHit> &indexes);
+   AtTrack CreateTrack(AtPattern *pattern, const std::vector<AtHit> &hitArray, const std::vector<std::size_t> &inliers);
 };
 } // namespace SampleConsensus
 #endif
@@ -1,8 +1,31 @@
 #include "AtSampleEstimator.h"
 
 #include "AtEstimatorMethods.h"
+#include "AtHit.h" // for AtHit
+#include "AtPattern.h"
 
 using namespace SampleConsensus;
+
+AtHitBuffer::AtHitBuffer(const std::vector<AtHit> &hits)
+{
+   Fill(hits);
+}
+
+void AtHitBuffer::Fill(const std::vector<AtHit> &hits)
+{
+   fX.resize(hits.size());
+   fY.resize(hits.size());
+   fZ.resize(hits.size());
+   fCharge.resize(hits.size());
+   for (std::size_t i = 0; i < hits.size(); ++i) {
+      const auto &pos = hits[i].GetPosition();
+      fX[i] = pos.X();
+      fY[i] = pos.Y();
+      fZ[i] = pos.Z();
+      fCharge[i] = hits[i].GetCharge();
+   }
+}
+
 /**
  * @brief Evaluate how well model describes hits
  *
@@ -19,12 +42,30 @@ using namespace SampleConsensus;
 int AtEstimator::EvaluateModel(AtPatterns::AtPattern *model, const std::vector<AtHit> &hits, double distThresh,
                                Estimators estimator = Estimators::kRANSAC)
 {
+   std::vector<double> distances;
+   return EvaluateModel(model, AtHitBuffer(hits), distThresh, estimator, distances);
+}
+
+/**
+ * @brief Evaluate how well model describes hits
+ *
+ * Same as above, but with the hits already packed. The distance of every hit to the model is calculated once
+ * and passed to the estimator.
+ *
+ * @param[out] distances Scratch space for the distance of each hit to the model. Resized as needed.
+ */
+int AtEstimator::EvaluateModel(AtPatterns::AtPattern *model, const AtHitBuffer &hits, double distThresh,
+                               Estimators estimator, std::vector<double> &distances)
+{
+   distances.resize(hits.size());
+   model->DistancesToPattern(hits.fX.data(), hits.fY.data(), hits.fZ.data(), hits.size(), distances.data());
+
    switch (estimator) {
-   case (Estimators::kRANSAC): return EvaluateRansac(model, hits, distThresh);
-   case (Estimators::kLMedS): return EvaluateLmeds(model, hits, distThresh);
-   case (Estimators::kMLESAC): return EvaluateMlesac(model, hits, distThresh);
-   case (Estimators::kWRANSAC): return EvaluateWeightedRansac(model, hits, distThresh);
-   case (Estimators::kChi2): return EvaluateChi2(model, hits, distThresh);
+   case (Estimators::kRANSAC): return EvaluateRansac(model, distances, distThresh);
+   case (Estimators::kLMedS): return EvaluateLmeds(model, distances, distThresh);
+   case (Estimators::kMLESAC): return EvaluateMlesac(model, distances, distThresh);
+   case (Estimators::kWRANSAC): return EvaluateWeightedRansac(model, distances, hits.fCharge, distThresh);
+   case (Estimators::kChi2): return EvaluateChi2(model, distances, distThresh);
    default: return 0;
    }
 }
@@ -1,6 +1,7 @@
 #ifndef ATSAMPLEESTIMATOR_H
 #define ATSAMPLEESTIMATOR_H
 
+#include <cstddef>
 #include <vector>
 namespace AtPatterns {
 class AtPattern;
@@ -10,6 +11,26 @@ class AtHit;
 namespace SampleConsensus {
 enum class Estimators;
 
+/**
+ * @brief Position and charge of hits packed into contiguous arrays.
+ *
+ * Built once from a hit array so evaluating a model only has to read the data it uses.
+ * @ingroup SampleConsensus
+ */
+struct AtHitBuffer {
+   std::vector<double> fX;
+   std::vector<double> fY;
+   std::vector<double> fZ;
+   std::vector<double> fCharge;
+
+   AtHitBuffer() = default;
+   AtHitBuffer(const std::vector<AtHit> &hits);
+
+   void Fill(const std::vector<AtHit> &hits);
+   std::size_t size() const { return fX.size(); }
+   bool empty() const { return fX.empty(); }
+};
+
 /**
  * Static class for calling the correct estimator based on the enum
  * Enum definition and implementation is in AtEstimatorMethods.h
@@ -19,6 +40,8 @@ class AtEstimator {
 public:
    static int
    EvaluateModel(AtPatterns::AtPattern *model, const std::vector<AtHit> &hits, double distThresh, Estimators estimator);
+   static int EvaluateModel(AtPatterns::AtPattern *model, const AtHitBuffer &hits, double distThresh,
+                            Estimators estimator, std::vector<double> &distances);
 };
 } // namespace SampleConsensus
 
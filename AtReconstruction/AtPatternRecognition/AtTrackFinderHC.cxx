@@ -109,8 +109,7 @@ void AtPATTERN::AtTrackFinderHC::eventToClusters(AtEvent &event, pcl::PointCloud
 
    for (Int_t iHit = 0; iHit < nHits; iHit++) {
 
-      const AtHit hit = event.GetHit(iHit);
-      auto position = hit.GetPosition();
+      auto position = event.GetHit(iHit).GetPosition();
       cloud->points[iHit].x = position.X();
       cloud->points[iHit].y = position.Y();
       cloud->points[iHit].z = position.Z();
@@ -123,8 +122,7 @@ std::unique_ptr<AtPatternEvent> AtPATTERN::AtTrackFinderHC::clustersToTrack(pcl:
                                                                             Cluster const cluster, AtEvent &event)
 {
    std::vector<AtTrack> tracks;
-
-   std::vector<pcl::PointXYZI, Eigen::aligned_allocator<pcl::PointXYZI>> points = cloud->points;
+   std::vector<bool> isClustered(event.GetNumHits(), false);
 
    std::vector<pcl::PointIndicesPtr> clusters = cluster.getClusters();
 
@@ -135,22 +133,11 @@ std::unique_ptr<AtPatternEvent> AtPATTERN::AtTrackFinderHC::clustersToTrack(pcl:
       pcl::PointIndicesPtr const &pointIndices = clusters[clusterIndex];
       // get color colour
 
+      track.GetHitArray().reserve(pointIndices->indices.size());
       for (int index : pointIndices->indices) {
-         pcl::PointXYZI point = cloud->points[index];
-
-         track.AddHit(event.GetHit(point.intensity));
-
-         // remove clustered points from point-vector
-         for (auto it = points.end(); it != points.begin(); --it) {
-            if (it->x == point.x && it->y == point.y && it->z == point.z) {
-
-               if (it != points.end()) {
-                  points.erase(it);
-                  break;
-               }
-            }
-         }
-
+         auto hitIndex = static_cast<size_t>(cloud->points[index].intensity);
+         track.AddHit(event.GetHit(hitIndex));
+         isClustered[hitIndex] = true;
       } // Indices loop
 
       track.SetTrackID(clusterIndex);
@@ -160,52 +147,23 @@ std::unique_ptr<AtPatternEvent> AtPATTERN::AtTrackFinderHC::clustersToTrack(pcl:
       if (kSetPrunning)
          PruneTrack(track);
 
-      tracks.push_back(track);
+      tracks.push_back(std::move(track));
 
    } // Clusters loop
 
    std::cout << cRED << " Tracks found " << tracks.size() << cNORMAL << "\n";
 
-   // Dump noise into pattern event
+   // Dump noise (every hit not in a cluster) into pattern event
    auto retEvent = std::make_unique<AtPatternEvent>();
-   for (const auto &point : points)
-      retEvent->AddNoise(event.GetHit(point.intensity));
+   for (size_t iHit = 0; iHit < isClustered.size(); ++iHit)
+      if (!isClustered[iHit])
+         retEvent->AddNoise(event.GetHit(iHit));
 
-   for (auto &track : tracks) {
-      if (track.GetHitArray().size() > 0)
-         SetTrackInitialParameters(track);
+   SetTracksInitialParameters(tracks);
+   for (auto &track : tracks)
       retEvent->AddTrack(std::move(track));
-   }
-   return retEvent;
-   /*ROOT::EnableThreadSafety();
-
-   //Estimaton of track parameters
-   std::vector<std::future<void>> futures;
-   futures.reserve(10);
-
-   for(auto& track : tracks)
-   {
 
-      futures.push_back( std::async(std::launch::async,&AtPRA::SetTrackInitialParameters,this,std::ref(track)) );
-      //std::cout<<" Processing track "<<"\n";
-      //SetTrackInitialParameters(track);
-
-   }
-
-   for(auto& future : futures) future.wait();
-
-   for(auto& track : tracks)
-   {
-     std::vector<Double_t>& coeffs = track.GetRANSACCoeff();
-
-     std::cout<<" RANSAC coeff for Track "<<track.GetTrackID()<<"\n";
-
-       for(auto& coeff : coeffs){
-
-    std::cout<<coeff<<"\n";
-       }
-
-       }*/
+   return retEvent;
 }
 
 ClassImp(AtPATTERN::AtTrackFinderHC)
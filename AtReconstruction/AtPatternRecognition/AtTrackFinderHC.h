@@ -54,6 +54,7 @@ public:
    ~AtTrackFinderHC() = default;
 
    std::unique_ptr<AtPatternEvent> FindTracks(AtEvent &event) override;
+   std::unique_ptr<AtPRA> Clone() override { return std::make_unique<AtTrackFinderHC>(*this); }
 
    void SetScluster(float s) { inputParams.s = s; }
    void SetKtriplet(size_t k) { inputParams.k = k; }
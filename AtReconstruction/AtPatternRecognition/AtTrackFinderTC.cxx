@@ -3,6 +3,7 @@
 #include "AtEvent.h"        // for AtEvent
 #include "AtHit.h"          // for AtHit
 #include "AtPatternEvent.h" // for AtPatternEvent
+#include "AtSpatialIndex.h"
 #include "AtTrack.h"        // for AtTrack
 
 #include <Math/Point3D.h> // for PositionVector3D
@@ -17,16 +18,84 @@
 #include "pointcloud.h"
 
 #include <algorithm>
-#include <cmath>    // for sqrt
-#include <iostream> // for cout, cerr
-#include <memory>   // for allocator_traits<>::value_...
-#include <utility>  // for move
+#include <cmath>      // for sqrt
+#include <functional> // for function
+#include <iostream>   // for cout, cerr
+#include <memory>     // for allocator_traits<>::value_...
+#include <numeric>    // for iota
+#include <thread>     // for thread
+#include <utility>    // for move, pair
+#include <vector>
 
 constexpr auto cRED = "\033[1;31m";
 constexpr auto cYELLOW = "\033[1;33m";
 constexpr auto cNORMAL = "\033[0m";
 constexpr auto cGREEN = "\033[1;32m";
 
+namespace {
+/// First quartile of the squared distance from each point to its nearest neighbor (as first_quartile in triplclust)
+double FirstQuartile(const PointCloud &cloud, const AtTools::AtSpatialIndex &index)
+{
+   std::vector<double> msd;
+   msd.reserve(cloud.size());
+   std::vector<double> dist2;
+   for (const auto &point : cloud) {
+      index.GetKNearest({point.x, point.y, point.z}, 2, &dist2); // The first point is the point itself
+      msd.push_back(dist2.size() > 1 ? dist2[1] : 0);
+   }
+   auto q1 = msd.size() / 4;
+   std::nth_element(msd.begin(), msd.begin() + q1, msd.end());
+   return msd[q1];
+}
+
+/// Replace each point with the centroid of the points within r (same as smoothen_cloud in triplclust)
+void SmoothenCloud(const PointCloud &cloud, const AtTools::AtSpatialIndex &index, PointCloud &result, double r)
+{
+   if (r == 0) {
+      result = cloud;
+      return;
+   }
+
+   for (const auto &point : cloud) {
+      auto neighbors = index.GetInRadius({point.x, point.y, point.z}, r);
+      double x = 0, y = 0, z = 0;
+      for (auto i : neighbors) {
+         x += cloud[i].x;
+         y += cloud[i].y;
+         z += cloud[i].z;
+      }
+      result.push_back(Point(x / neighbors.size(), y / neighbors.size(), z / neighbors.size()));
+   }
+}
+
+std::size_t NumBlocks(std::size_t n, Int_t numThreads)
+{
+   return std::max<std::size_t>(1, std::min<std::size_t>(std::max(numThreads, 1), n));
+}
+
+/// Call func(block, begin, end) for numBlocks contiguous blocks of [0, n), each on its own thread
+void ForEachBlock(std::size_t n, std::size_t numBlocks,
+                  const std::function<void(std::size_t, std::size_t, std::size_t)> &func)
+{
+   auto perBlock = (n + numBlocks - 1) / numBlocks;
+   std::vector<std::thread> threads;
+   for (std::size_t i = 1; i < numBlocks; ++i)
+      threads.emplace_back(func, i, std::min(n, i * perBlock), std::min(n, (i + 1) * perBlock));
+   func(0, 0, std::min(n, perBlock));
+   for (auto &thread : threads)
+      thread.join();
+}
+
+std::vector<ROOT::Math::XYZPoint> ToXYZ(const PointCloud &cloud)
+{
+   std::vector<ROOT::Math::XYZPoint> points;
+   points.reserve(cloud.size());
+   for (const auto &point : cloud)
+      points.emplace_back(point.x, point.y, point.z);
+   return points;
+}
+} // namespace
+
 AtPATTERN::AtTrackFinderTC::AtTrackFinderTC() : AtPATTERN::AtPRA() {}
 
 std::unique_ptr<AtPatternEvent> AtPATTERN::AtTrackFinderTC::FindTracks(AtEvent &event)
@@ -46,8 +115,11 @@ std::unique_ptr<AtPatternEvent> AtPATTERN::AtTrackFinderTC::FindTracks(AtEvent &
       return NULL;
    }
 
+   // One index serves both the dnn and the smoothing
+   AtTools::AtSpatialIndex index(ToXYZ(cloud_xyz));
+
    if (opt_params.needs_dnn()) {
-      double dnn = std::sqrt(first_quartile(cloud_xyz));
+      double dnn = std::sqrt(FirstQuartile(cloud_xyz, index));
       if (opt_verbose > 0) {
          std::cout << "AtPATTERN::AtTrackFinderTC - [Info] computed dnn: " << dnn << std::endl;
       }
@@ -61,16 +133,19 @@ std::unique_ptr<AtPatternEvent> AtPATTERN::AtTrackFinderTC::FindTracks(AtEvent &
 
    // Step 1) smoothing by position averaging of neighboring points
    PointCloud cloud_xyz_smooth;
-   smoothen_cloud(cloud_xyz, cloud_xyz_smooth, opt_params.get_r());
+   SmoothenCloud(cloud_xyz, index, cloud_xyz_smooth, opt_params.get_r());
 
    // Step 2) finding triplets of approximately collinear points
    std::vector<triplet> triplets;
-   generate_triplets(cloud_xyz_smooth, triplets, opt_params.get_k(), opt_params.get_n(), opt_params.get_a());
+   generateTriplets(cloud_xyz_smooth, triplets, opt_params.get_k(), opt_params.get_n(), opt_params.get_a());
 
    // Step 3) single link hierarchical clustering of the triplets
    cluster_group cl_group;
-   compute_hc(cloud_xyz_smooth, cl_group, triplets, opt_params.get_s(), opt_params.get_t(), opt_params.is_tauto(),
-              opt_params.get_dmax(), opt_params.is_dmax(), opt_params.get_linkage(), opt_verbose);
+   if (fLinkageRadius > 0 && opt_params.get_linkage() == SINGLE && !opt_params.is_tauto())
+      sparseSingleLinkage(triplets, cl_group, opt_params.get_s(), opt_params.get_t());
+   else
+      compute_hc(cloud_xyz_smooth, cl_group, triplets, opt_params.get_s(), opt_params.get_t(), opt_params.is_tauto(),
+                 opt_params.get_dmax(), opt_params.is_dmax(), opt_params.get_linkage(), opt_verbose);
 
    // Step 4) pruning by removal of small clusters ...
    cleanup_cluster_group(cl_group, opt_params.get_m(), opt_verbose);
@@ -91,14 +166,135 @@ std::unique_ptr<AtPatternEvent> AtPATTERN::AtTrackFinderTC::FindTracks(AtEvent &
    return clustersToTrack(cloud_xyz, cl_group, event);
 }
 
+/**
+ * Same as generate_triplets in triplclust, but the points are split over fNumThreads threads. Each thread
+ * handles a contiguous block of points, so the triplets are in the same order for any number of threads.
+ */
+void AtPATTERN::AtTrackFinderTC::generateTriplets(const PointCloud &cloud, std::vector<triplet> &triplets, size_t k,
+                                                  size_t n, double a)
+{
+   AtTools::AtSpatialIndex index(ToXYZ(cloud));
+
+   auto numBlocks = NumBlocks(cloud.size(), fNumThreads);
+   std::vector<std::vector<triplet>> blockTriplets(numBlocks);
+   ForEachBlock(cloud.size(), numBlocks, [&](std::size_t block, std::size_t begin, std::size_t end) {
+      auto &blockResult = blockTriplets[block];
+      std::vector<double> distances;
+      std::vector<triplet> triplet_candidates;
+
+      for (size_t point_index_b = begin; point_index_b < end; ++point_index_b) {
+         const Point &point_b = cloud[point_index_b];
+         auto result = index.GetKNearest({point_b.x, point_b.y, point_b.z}, k, &distances);
+         triplet_candidates.clear();
+
+         for (size_t result_index_a = 1; result_index_a < result.size(); ++result_index_a) {
+            // When the distance is 0, we have the same point as point_b
+            if (distances[result_index_a] == 0)
+               continue;
+            const Point &point_a = cloud[result[result_index_a]];
+
+            Point direction_ab = point_b - point_a;
+            direction_ab = direction_ab / direction_ab.norm();
+
+            for (size_t result_index_c = result_index_a + 1; result_index_c < result.size(); ++result_index_c) {
+               if (distances[result_index_c] == 0)
+                  continue;
+               const Point &point_c = cloud[result[result_index_c]];
+
+               Point direction_bc = point_c - point_b;
+               direction_bc = direction_bc / direction_bc.norm();
+
+               const double error = 1.0f - direction_ab * direction_bc;
+               if (error <= a) {
+                  triplet new_triplet;
+                  new_triplet.point_index_a = result[result_index_a];
+                  new_triplet.point_index_b = point_index_b;
+                  new_triplet.point_index_c = result[result_index_c];
+                  new_triplet.center = (point_a + point_b + point_c) / 3.0f;
+                  new_triplet.direction = direction_bc;
+                  new_triplet.error = error;
+                  triplet_candidates.push_back(new_triplet);
+               }
+            }
+         }
+
+         // use the n best candidates
+         std::sort(triplet_candidates.begin(), triplet_candidates.end());
+         for (size_t i = 0; i < std::min(n, triplet_candidates.size()); ++i)
+            blockResult.push_back(triplet_candidates[i]);
+      }
+   });
+
+   for (auto &block : blockTriplets)
+      triplets.insert(triplets.end(), block.begin(), block.end());
+}
+
+/**
+ * Single linkage clustering of the triplets cut at t, without the dense distance matrix.
+ *
+ * The clusters of single linkage cut at t are the connected components of the graph linking every pair of
+ * triplets closer than t. Only pairs with centers within fLinkageRadius are tested, using a spatial index
+ * over the centers. The pairs are found in parallel and merged with a union-find. Clusters are ordered by
+ * their first triplet.
+ */
+void AtPATTERN::AtTrackFinderTC::sparseSingleLinkage(const std::vector<triplet> &triplets, cluster_group &result,
+                                                     double s, double t)
+{
+   if (triplets.empty())
+      return;
+
+   std::vector<ROOT::Math::XYZPoint> centers;
+   centers.reserve(triplets.size());
+   for (const auto &trip : triplets)
+      centers.emplace_back(trip.center.x, trip.center.y, trip.center.z);
+   AtTools::AtSpatialIndex index(centers);
+
+   auto numBlocks = NumBlocks(triplets.size(), fNumThreads);
+   std::vector<std::vector<std::pair<size_t, size_t>>> blockEdges(numBlocks);
+   ForEachBlock(triplets.size(), numBlocks, [&](std::size_t block, std::size_t begin, std::size_t end) {
+      auto &edges = blockEdges[block];
+      ScaleTripletMetric metric(s);
+      for (size_t i = begin; i < end; ++i)
+         for (auto j : index.GetInRadius(centers[i], fLinkageRadius))
+            if (j > i && metric(triplets[i], triplets[j]) < t)
+               edges.emplace_back(i, j);
+   });
+
+   std::vector<size_t> parent(triplets.size());
+   std::iota(parent.begin(), parent.end(), 0);
+   auto findRoot = [&parent](size_t i) {
+      while (parent[i] != i)
+         i = parent[i] = parent[parent[i]];
+      return i;
+   };
+   for (const auto &edges : blockEdges) {
+      for (const auto &[i, j] : edges) {
+         auto rootI = findRoot(i);
+         auto rootJ = findRoot(j);
+         if (rootI != rootJ)
+            parent[std::max(rootI, rootJ)] = std::min(rootI, rootJ);
+      }
+   }
+
+   // The root of each cluster is its first triplet
+   std::vector<size_t> label(triplets.size());
+   for (size_t i = 0; i < triplets.size(); ++i) {
+      auto root = findRoot(i);
+      if (root == i) {
+         label[i] = result.size();
+         result.emplace_back();
+      }
+      result[label[root]].push_back(i);
+   }
+}
+
 void AtPATTERN::AtTrackFinderTC::eventToClusters(AtEvent &event, PointCloud &cloud)
 {
    Int_t nHits = event.GetNumHits();
 
    for (Int_t iHit = 0; iHit < nHits; iHit++) {
       Point point;
-      const AtHit hit = event.GetHit(iHit);
-      auto position = hit.GetPosition();
+      auto position = event.GetHit(iHit).GetPosition();
       point.x = position.X();
       point.y = position.Y();
       point.z = position.Z();
@@ -112,7 +308,7 @@ AtPATTERN::AtTrackFinderTC::clustersToTrack(PointCloud &cloud, const std::vector
 {
 
    std::vector<AtTrack> tracks;
-   std::vector<Point> points = cloud;
+   std::vector<bool> isClustered(event.GetNumHits(), false);
 
    for (size_t cluster_index = 0; cluster_index < clusters.size(); ++cluster_index) {
 
@@ -123,20 +319,11 @@ AtPATTERN::AtTrackFinderTC::clustersToTrack(PointCloud &cloud, const std::vector
          continue;
 
       // add points
-      for (std::vector<size_t>::const_iterator it = point_indices.begin(); it != point_indices.end(); ++it) {
-
-         const Point &point = cloud[*it];
-
-         track.AddHit(event.GetHit(point.GetID()));
-
-         // remove current point from vector points
-         for (std::vector<Point>::iterator p = points.begin(); p != points.end(); p++) {
-            if (*p == point) {
-               points.erase(p);
-               break;
-            }
-         }
-
+      track.GetHitArray().reserve(point_indices.size());
+      for (auto index : point_indices) {
+         auto hitIndex = cloud[index].GetID();
+         track.AddHit(event.GetHit(hitIndex));
+         isClustered[hitIndex] = true;
       } // Point indices
 
       track.SetTrackID(cluster_index);
@@ -146,22 +333,21 @@ AtPATTERN::AtTrackFinderTC::clustersToTrack(PointCloud &cloud, const std::vector
       if (kSetPrunning)
          PruneTrack(track);
 
-      tracks.push_back(track);
+      tracks.push_back(std::move(track));
 
    } // Clusters loop
 
    std::cout << cRED << " Tracks found " << tracks.size() << cNORMAL << "\n";
 
-   // Dump noise into pattern event
+   // Dump noise (every hit not in a cluster) into pattern event
    auto retEvent = std::make_unique<AtPatternEvent>();
-   for (const auto &point : points)
-      retEvent->AddNoise(event.GetHit(point.GetID()));
+   for (size_t iHit = 0; iHit < isClustered.size(); ++iHit)
+      if (!isClustered[iHit])
+         retEvent->AddNoise(event.GetHit(iHit));
 
-   for (auto &track : tracks) {
-      if (track.GetHitArray().size() > 0)
-         SetTrackInitialParameters(track);
+   SetTracksInitialParameters(tracks);
+   for (auto &track : tracks)
       retEvent->AddTrack(std::move(track));
-   }
 
    return retEvent;
 }
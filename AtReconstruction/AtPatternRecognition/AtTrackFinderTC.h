@@ -41,12 +41,14 @@ struct hc_params {
 class AtTrackFinderTC : public AtPRA {
 private:
    hc_params inputParams{.s = 0.3, .k = 19, .n = 2, .m = 15, .r = 2, .a = 0.03, .t = 4.0};
+   Double_t fLinkageRadius{0}; //< If > 0, triplets are clustered with sparse single linkage
 
 public:
    AtTrackFinderTC();
    ~AtTrackFinderTC() = default;
 
    std::unique_ptr<AtPatternEvent> FindTracks(AtEvent &event) override;
+   std::unique_ptr<AtPRA> Clone() override { return std::make_unique<AtTrackFinderTC>(*this); }
 
    void SetScluster(float s) { inputParams.s = s; }
    void SetKtriplet(size_t k) { inputParams.k = k; }
@@ -57,12 +59,25 @@ public:
    void SetTcluster(float t) { inputParams.t = t; }
    void SetPadding(size_t padding) { inputParams._padding = padding; }
 
+   /**
+    * @brief Use sparse single linkage to cluster the triplets.
+    *
+    * Only triplets with centers within **radius** (mm) of each other are compared, and the clusters are the
+    * connected components of the pairs closer than t. This avoids the dense distance matrix over all
+    * triplets, which grows as the square of the number of triplets. Gives the same clusters as the default
+    * linkage if every pair closer than t has centers within radius. Set to 0 (default) to use the dense
+    * linkage.
+    */
+   void SetSparseLinkage(Double_t radius) { fLinkageRadius = radius; }
+
 private:
    void eventToClusters(AtEvent &event, PointCloud &cloud);
+   void generateTriplets(const PointCloud &cloud, std::vector<triplet> &triplets, size_t k, size_t n, double a);
+   void sparseSingleLinkage(const std::vector<triplet> &triplets, cluster_group &result, double s, double t);
    std::unique_ptr<AtPatternEvent>
    clustersToTrack(PointCloud &cloud, const std::vector<cluster_t> &clusters, AtEvent &event);
 
-   ClassDefOverride(AtTrackFinderTC, 1);
+   ClassDefOverride(AtTrackFinderTC, 2);
 };
 
 } // namespace AtPATTERN
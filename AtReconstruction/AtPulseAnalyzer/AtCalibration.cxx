@@ -77,11 +77,7 @@ const trace &AtCalibration::CalibrateGain(const trace &adc, Int_t padNum)
    }
 
    fPadNum = padNum;
-   fGnewadc[512] = 0;
-
-   for (Int_t i = 0; i < 512; i++)
-      fGnewadc[i] = adc[i] * fGainCalib[fPadNum];
-
+   CalibrateGain(adc, padNum, fGnewadc);
    return fGnewadc;
 }
 
@@ -92,15 +88,41 @@ const trace &AtCalibration::CalibrateJitter(const trace &adc, Int_t padNum)
    }
 
    fPadNum = padNum;
-   fGnewadc[512] = 0;
+   if (&adc == &fGnewadc) {
+      trace input = adc;
+      CalibrateJitter(input, padNum, fGnewadc);
+   } else {
+      CalibrateJitter(adc, padNum, fGnewadc);
+   }
+   return fGnewadc;
+}
+
+void AtCalibration::CalibrateGain(const trace &adc, Int_t padNum, trace &out) const
+{
+   if (!fIsGainCalibrated) {
+      out = adc;
+      return;
+   }
+
+   for (Int_t i = 0; i < 512; i++)
+      out[i] = adc[i] * fGainCalib[padNum];
+}
+
+void AtCalibration::CalibrateJitter(const trace &adc, Int_t padNum, trace &out) const
+{
+   if (!fIsJitterCalibrated) {
+      out = adc;
+      return;
+   }
+
+   out.fill(0);
    Int_t tcorr = 0;
 
    for (Int_t j = 0; j < 512; j++) {
-      tcorr = j + fJitterCalib[fPadNum];
-      if (tcorr >= 0 && tcorr <= 512 && adc[j] > 0 && adc[j] < 4000) {
-         fGnewadc[tcorr] = adc[j];
+      tcorr = j + fJitterCalib[padNum];
+      if (tcorr >= 0 && tcorr < 512 && adc[j] > 0 && adc[j] < 4000) {
+         out[tcorr] = adc[j];
          // std::cout<<"fGnewadc: "<< fGnewadc[tcorr]<< std::endl;
       }
    }
-   return fGnewadc;
 }
@@ -35,6 +35,10 @@ public:
 
    const trace &CalibrateGain(const trace &adc, Int_t padNum);
    const trace &CalibrateJitter(const trace &adc, Int_t padNum);
+   /// Calibrate into out instead of a member, so several threads can use the same calibration
+   void CalibrateGain(const trace &adc, Int_t padNum, trace &out) const;
+   /// Calibrate into out (which must not be adc) instead of a member. Samples nothing is shifted into are 0.
+   void CalibrateJitter(const trace &adc, Int_t padNum, trace &out) const;
 
    Bool_t IsGainFile();
    Bool_t IsJitterFile();
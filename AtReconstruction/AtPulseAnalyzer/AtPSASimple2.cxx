@@ -17,250 +17,295 @@
 #include <algorithm>
 #include <array> // for array
 #include <cmath>
-#include <iostream> // for basic_ostream::operator<<
+#include <functional> // for ref
+#include <iostream>   // for basic_ostream::operator<<
 #include <map>
 #include <memory>  // for unique_ptr, make_unique
+#include <thread>  // for thread
 #include <utility> // for pair
 #include <vector>  // for vector
 
-//#ifdef _OPENMP
-//#include <omp.h>
-//#endif
 using XYZPoint = ROOT::Math::XYZPoint;
 ClassImp(AtPSASimple2);
 
+AtPSASimple2::Workspace::Workspace()
+   : fPeakFinder(std::make_unique<TSpectrum>()), fBackground(std::make_unique<TSpectrum>())
+{
+}
+
+AtPSASimple2::Workspace::~Workspace() = default;
+
+void AtPSASimple2::Workspace::Reset()
+{
+   fHits.clear();
+   fPadsWithPeaks.clear();
+   fMesh.fill(0);
+   fQEventTot = 0;
+   fRhoMean = 0;
+   fRho2 = 0;
+}
+
 void AtPSASimple2::Analyze(AtRawEvent *rawEvent, AtEvent *event)
 {
+   LOG(debug) << "MC Simulated points Map size " << rawEvent->GetSimMCPointMap().size();
+
+   auto numPads = rawEvent->GetPads().size();
+   auto numThreads = std::max<std::size_t>(1, std::min<std::size_t>(fNumThreads, numPads));
+   if (fWorkspaces.size() < numThreads)
+      fWorkspaces.resize(numThreads);
+
+   // Each thread gets a contiguous block of pads, so concatenating the results in thread order
+   // gives the hits in the same order as analyzing the pads serially.
+   auto padsPerThread = (numPads + numThreads - 1) / numThreads;
+   if (numThreads == 1) {
+      AnalyzePads(rawEvent, 0, numPads, fWorkspaces[0]);
+   } else {
+      std::vector<std::thread> threads;
+      for (std::size_t i = 0; i < numThreads; ++i) {
+         auto begin = std::min(numPads, i * padsPerThread);
+         auto end = std::min(numPads, (i + 1) * padsPerThread);
+         threads.emplace_back(&AtPSASimple2::AnalyzePads, this, rawEvent, begin, end, std::ref(fWorkspaces[i]));
+      }
+      for (auto &thread : threads)
+         thread.join();
+   }
 
-   Int_t hitNum = 0;
    Double_t QEventTot = 0.0;
-   Double_t RhoVariance = 0.0;
    Double_t RhoMean = 0.0;
    Double_t Rho2 = 0.0;
    std::map<Int_t, Int_t> PadMultiplicity;
    std::array<Float_t, 512> mesh{};
-   mesh.fill(0);
 
-   auto mcPointsMap = rawEvent->GetSimMCPointMap();
-   LOG(debug) << "MC Simulated points Map size " << mcPointsMap.size();
+   for (std::size_t i = 0; i < numThreads; ++i) {
+      auto &ws = fWorkspaces[i];
+      for (const auto &info : ws.fHits) {
+         auto &hit = event->AddHit(info.fPadNum, info.fPosition, info.fCharge);
+         LOG(debug) << "Added hit with ID" << hit.GetHitID();
+
+         hit.SetTimeStamp(info.fTimeStamp);
+         hit.SetTimeStampCorr(info.fTimeStampCorr);
+         hit.SetTimeStampCorrInter(info.fTimeStampCorrInter);
+         hit.SetTraceIntegral(info.fTraceIntegral);
+         // TODO: The charge of each hit is the total charge of the spectrum, so for double
+         // structures this is unrealistic.
+      }
 
-   //#pragma omp parallel for ordered schedule(dynamic,1) private(iPad)
-   for (const auto &pad : rawEvent->GetPads()) {
+      for (auto padNum : ws.fPadsWithPeaks)
+         PadMultiplicity.insert(std::pair<Int_t, Int_t>(padNum, 1));
 
-      LOG(debug) << "Running PSA on pad " << pad->GetPadNum();
-      Int_t PadNum = pad->GetPadNum();
-      Int_t pSizeID = pad->GetSizeID();
-      Double_t gthreshold = -1;
-      if (pSizeID == 0)
-         gthreshold = fThresholdlow; // threshold for central pads
-      else
-         gthreshold = fThreshold; // threshold for big pads (or all other not small)
+      QEventTot += ws.fQEventTot;
+      RhoMean += ws.fRhoMean;
+      Rho2 += ws.fRho2;
+      for (Int_t iTb = 0; iTb < fNumTbs; iTb++)
+         mesh[iTb] += ws.fMesh[iTb];
+   }
 
-      Double_t QHitTot = 0.0;
-      XYZPoint HitPos;
-      ROOT::Math::Rotation3D HitPosRot;
+   // RhoVariance = Rho2 - (pow(RhoMean, 2) / (event->GetNumHits()));
+   Double_t RhoVariance = Rho2 - (event->GetNumHits() * pow((RhoMean / event->GetNumHits()), 2));
 
-      Bool_t fValidBuff = kTRUE;
-      Bool_t fValidThreshold = kTRUE;
-      Bool_t fValidDerivative = kTRUE;
+   for (Int_t iTb = 0; iTb < fNumTbs; iTb++)
+      event->SetMeshSignal(iTb, mesh[iTb]);
+   event->SortHitArrayTime();
+   event->SetMultiplicityMap(PadMultiplicity);
+   event->SetRhoVariance(RhoVariance);
+   event->SetEventCharge(QEventTot);
+}
 
-      auto pos = pad->GetPadCoord();
-      Double_t zPos = 0;
-      Double_t charge = 0;
-      Int_t maxAdcIdx = 0;
-      Int_t numPeaks = 0;
+void AtPSASimple2::AnalyzePads(const AtRawEvent *rawEvent, std::size_t begin, std::size_t end, Workspace &ws)
+{
+   ws.Reset();
+   const auto &pads = rawEvent->GetPads();
+   for (auto i = begin; i < end; ++i)
+      AnalyzePad(*pads[i], ws);
+}
 
-      if (pos.X() < -9000 || pos.Y() < -9000) {
-         LOG(debug) << "Skipping pad, position is invalid";
-         continue;
+void AtPSASimple2::AnalyzePad(const AtPad &inputPad, Workspace &ws)
+{
+   const AtPad *pad = &inputPad;
+   LOG(debug) << "Running PSA on pad " << pad->GetPadNum();
+   Int_t PadNum = pad->GetPadNum();
+   Int_t pSizeID = pad->GetSizeID();
+   Double_t gthreshold = -1;
+   if (pSizeID == 0)
+      gthreshold = fThresholdlow; // threshold for central pads
+   else
+      gthreshold = fThreshold; // threshold for big pads (or all other not small)
+
+   Double_t QHitTot = 0.0;
+
+   Bool_t fValidBuff = kTRUE;
+   Bool_t fValidThreshold = kTRUE;
+   Bool_t fValidDerivative = kTRUE;
+
+   auto pos = pad->GetPadCoord();
+   Double_t zPos = 0;
+   Double_t charge = 0;
+   Int_t maxAdcIdx = 0;
+   Int_t numPeaks = 0;
+
+   if (pos.X() < -9000 || pos.Y() < -9000) {
+      LOG(debug) << "Skipping pad, position is invalid";
+      return;
+   }
+
+   if (!(pad->IsPedestalSubtracted())) {
+      LOG(ERROR) << "Pedestal should be subtracted to use this class!";
+   }
+
+   // Only copy the trace if it has to be calibrated. The calibration is shared by the threads, so it writes into
+   // buffers local to this call.
+   const AtPad::trace *adcPtr = &pad->GetADC();
+   AtPad::trace gainADC;
+   AtPad::trace calibratedADC;
+   if (fCalibration.IsGainFile() || fCalibration.IsJitterFile()) {
+      fCalibration.CalibrateGain(*adcPtr, PadNum, gainADC);
+      fCalibration.CalibrateJitter(gainADC, PadNum, calibratedADC);
+      adcPtr = &calibratedADC;
+   }
+   const auto &adc = *adcPtr;
+
+   std::array<Double_t, 512> floatADC{};
+   std::array<Double_t, 512> dummy{};
+   std::array<Double_t, 512> bg{};
+
+   for (Int_t iTb = 0; iTb < fNumTbs; iTb++) {
+      floatADC[iTb] = adc[iTb];
+      QHitTot += adc[iTb];
+   }
+
+   auto &PeakFinder = ws.fPeakFinder;
+   if (fIsPeakFinder)
+      numPeaks = PeakFinder->SearchHighRes(floatADC.data(), dummy.data(), fNumTbs, 4.7, 5, fBackGroundSuppression, 3,
+                                           kTRUE, 3);
+   if (fIsMaxFinder)
+      numPeaks = 1;
+
+   if (fBackGroundInterp) {
+      // SearchHighRes overwrites its input, so the background is estimated from the original trace
+      std::copy_n(adc.begin(), fNumTbs, bg.begin());
+      ws.fBackground->Background(bg.data(), fNumTbs, 6, TSpectrum::kBackDecreasingWindow, TSpectrum::kBackOrder2,
+                                 kTRUE, TSpectrum::kBackSmoothing7, kTRUE);
+      for (Int_t iTb = 1; iTb < fNumTbs; iTb++) {
+         floatADC[iTb] = floatADC[iTb] - bg[iTb];
+         if (floatADC[iTb] < 0)
+            floatADC[iTb] = 0;
       }
+   }
 
-      if (!(pad->IsPedestalSubtracted())) {
-         LOG(ERROR) << "Pedestal should be subtracted to use this class!";
-      }
+   if (numPeaks == 0)
+      fValidBuff = kFALSE;
+   // continue;
 
-      auto adc = pad->GetADC();
-      std::array<Double_t, 512> floatADC{};
-      std::array<Double_t, 512> dummy{};
-      std::array<Double_t, 512> bg{};
-      floatADC.fill(0);
-      dummy.fill(0);
-      bg.fill(0);
+   if (!fValidBuff)
+      return;
 
-      if (fCalibration.IsGainFile()) {
-         adc = fCalibration.CalibrateGain(adc, PadNum);
-      }
-      if (fCalibration.IsJitterFile()) {
-         adc = fCalibration.CalibrateJitter(adc, PadNum);
-      }
+   for (Int_t iPeak = 0; iPeak < numPeaks; iPeak++) {
 
-      for (Int_t iTb = 0; iTb < fNumTbs; iTb++) {
-         floatADC[iTb] = adc[iTb];
-         QHitTot += adc[iTb];
-         bg[iTb] = adc[iTb];
-      }
+      Float_t max = 0.0;
+      Float_t min = 0.0;
+      Int_t maxTime = 0;
 
-      auto PeakFinder = std::make_unique<TSpectrum>();
-      if (fIsPeakFinder)
-         numPeaks = PeakFinder->SearchHighRes(floatADC.data(), dummy.data(), fNumTbs, 4.7, 5, fBackGroundSuppression, 3,
-                                              kTRUE, 3);
-      if (fIsMaxFinder)
-         numPeaks = 1;
-
-      auto BGInter = std::make_unique<TSpectrum>();
-      if (fBackGroundInterp) {
-         BGInter->Background(bg.data(), fNumTbs, 6, TSpectrum::kBackDecreasingWindow, TSpectrum::kBackOrder2, kTRUE,
-                             TSpectrum::kBackSmoothing7, kTRUE);
-         for (Int_t iTb = 1; iTb < fNumTbs; iTb++) {
-            floatADC[iTb] = floatADC[iTb] - bg[iTb];
-            if (floatADC[iTb] < 0)
-               floatADC[iTb] = 0;
-         }
+      if (fIsPeakFinder) {
+         maxAdcIdx = (Int_t)(ceil((PeakFinder->GetPositionX())[iPeak]));
+         if (maxAdcIdx < 3 || maxAdcIdx > 509)
+            continue; // excluding the first and last 3 tb
       }
+      //  Int_t maxAdcIdx = *std::max_element(floatADC,floatADC+fNumTbs);
+
+      if (fIsMaxFinder) {
+         for (Int_t ij = 20; ij < 500; ij++) // Excluding first and last 12 Time Buckets
+         {
+            if (floatADC[ij] > max) {
+               max = floatADC[ij];
+               maxTime = ij;
+            }
+         }
 
-      if (numPeaks == 0)
-         fValidBuff = kFALSE;
-      // continue;
+         maxAdcIdx = maxTime;
+      }
+      // Charge Correction due to mesh induction (base line)
 
-      if (fValidBuff) {
+      Double_t basecorr = 0.0;
+      Double_t slope = 0.0;
+      Int_t slope_cnt = 0;
 
-         for (Int_t iPeak = 0; iPeak < numPeaks; iPeak++) {
+      if (maxAdcIdx > 20)
+         for (Int_t i = 0; i < 10; i++) {
 
-            Float_t max = 0.0;
-            Float_t min = 0.0;
-            Int_t maxTime = 0;
+            basecorr += floatADC[maxAdcIdx - 8 - i];
 
-            if (fIsPeakFinder) {
-               maxAdcIdx = (Int_t)(ceil((PeakFinder->GetPositionX())[iPeak]));
-               if (maxAdcIdx < 3 || maxAdcIdx > 509)
-                  continue; // excluding the first and last 3 tb
+            if (i < 5) {
+               slope = (floatADC[maxAdcIdx - i] - floatADC[maxAdcIdx - i - 1]); // Derivate for 5 Timebuckets
+               // if(slope<0 && floatADC[maxAdcIdx]<3500 && fIsBaseCorr && fIsMaxFinder)
+               // fValidDerivative = kFALSE; //3500 condition to avoid killing saturated pads
+               if (slope < 0 && fIsBaseCorr && fIsMaxFinder)
+                  slope_cnt++;
             }
-            //  Int_t maxAdcIdx = *std::max_element(floatADC,floatADC+fNumTbs);
-
-            if (fIsMaxFinder) {
-               for (Int_t ij = 20; ij < 500; ij++) // Excluding first and last 12 Time Buckets
-               {
-                  if (floatADC[ij] > max) {
-                     max = floatADC[ij];
-                     maxTime = ij;
-                  }
-               }
-
-               maxAdcIdx = maxTime;
-            }
-            // Charge Correction due to mesh induction (base line)
-
-            Double_t basecorr = 0.0;
-            Double_t slope = 0.0;
-            Int_t slope_cnt = 0;
-
-            if (maxAdcIdx > 20)
-               for (Int_t i = 0; i < 10; i++) {
-
-                  basecorr += floatADC[maxAdcIdx - 8 - i];
-
-                  if (i < 5) {
-                     slope = (floatADC[maxAdcIdx - i] - floatADC[maxAdcIdx - i - 1]); // Derivate for 5 Timebuckets
-                     // if(slope<0 && floatADC[maxAdcIdx]<3500 && fIsBaseCorr && fIsMaxFinder)
-                     // fValidDerivative = kFALSE; //3500 condition to avoid killing saturated pads
-                     if (slope < 0 && fIsBaseCorr && fIsMaxFinder)
-                        slope_cnt++;
-                  }
-               }
-            // Calculation of the mean value of the peak time by interpolating the pulse
-
-            Double_t timemax = 0.5 * (floatADC[maxAdcIdx - 1] - floatADC[maxAdcIdx + 1]) /
-                               (floatADC[maxAdcIdx - 1] + floatADC[maxAdcIdx + 1] - 2 * floatADC[maxAdcIdx]);
-
-            // Time Correction by Center of Gravity
-            Double_t TBCorr = 0.0;
-            Double_t TB_TotQ = 0.0;
-
-            if (maxAdcIdx > 11) {
-               for (Int_t i = 0; i < 11; i++) {
-
-                  if (floatADC[maxAdcIdx - i + 10] > 0 && floatADC[maxAdcIdx - i + 10] < 4000) {
-                     TBCorr += (floatADC[maxAdcIdx - i + 5] - basecorr / 10.0) *
-                               (maxAdcIdx - i + 5); // Substract the baseline correction
-                     TB_TotQ += floatADC[maxAdcIdx - i + 5] - basecorr / 10.0;
-                  }
-               }
-            }
-            TBCorr = TBCorr / TB_TotQ;
-
-            if (fIsBaseCorr)
-               charge = floatADC[maxAdcIdx] - basecorr / 10.0;
-            else
-               charge = floatADC[maxAdcIdx];
-
-            if (fIsTimeCorr)
-               zPos = CalculateZGeo(TBCorr);
-            else
-               zPos = CalculateZGeo(maxAdcIdx);
+         }
+      // Calculation of the mean value of the peak time by interpolating the pulse
 
-            if (gthreshold > 0 && charge < gthreshold) {
-               fValidThreshold = false;
-               LOG(debug) << "Invalid threshold with charge: " << charge << " and threshold: " << gthreshold;
-            }
-            if (fIsMaxFinder && (maxTime < 20 || maxTime > 500)) {
-               fValidThreshold = kFALSE;
-               LOG(debug) << "Peak is outside valid time window (20,500) TBs.";
-            }
+      Double_t timemax = 0.5 * (floatADC[maxAdcIdx - 1] - floatADC[maxAdcIdx + 1]) /
+                         (floatADC[maxAdcIdx - 1] + floatADC[maxAdcIdx + 1] - 2 * floatADC[maxAdcIdx]);
 
-            if (fValidThreshold && fValidDerivative) {
+      // Time Correction by Center of Gravity
+      Double_t TBCorr = 0.0;
+      Double_t TB_TotQ = 0.0;
 
-               // Sum only if Hit is valid - We only sum once (iPeak==0) to account for the
-               // whole spectrum.
-               if (iPeak == 0)
-                  QEventTot += QHitTot;
+      if (maxAdcIdx > 11) {
+         for (Int_t i = 0; i < 11; i++) {
 
-               auto &hit = event->AddHit(PadNum, XYZPoint(pos.X(), pos.Y(), zPos), charge);
-               LOG(debug) << "Added hit with ID" << hit.GetHitID();
+            if (floatADC[maxAdcIdx - i + 10] > 0 && floatADC[maxAdcIdx - i + 10] < 4000) {
+               TBCorr += (floatADC[maxAdcIdx - i + 5] - basecorr / 10.0) *
+                         (maxAdcIdx - i + 5); // Substract the baseline correction
+               TB_TotQ += floatADC[maxAdcIdx - i + 5] - basecorr / 10.0;
+            }
+         }
+      }
+      TBCorr = TBCorr / TB_TotQ;
 
-               hit.SetTimeStamp(maxAdcIdx);
-               hit.SetTimeStampCorr(TBCorr);
-               hit.SetTimeStampCorrInter(timemax);
+      if (fIsBaseCorr)
+         charge = floatADC[maxAdcIdx] - basecorr / 10.0;
+      else
+         charge = floatADC[maxAdcIdx];
 
-               hit.SetTraceIntegral(QHitTot);
-               // TODO: The charge of each hit is the total charge of the spectrum, so for double
-               // structures this is unrealistic.
+      if (fIsTimeCorr)
+         zPos = CalculateZGeo(TBCorr);
+      else
+         zPos = CalculateZGeo(maxAdcIdx);
 
-               HitPos = hit.GetPosition();
-               Rho2 += HitPos.Mag2();
-               RhoMean += HitPos.Rho();
-               if ((pos.X() < -9000 || pos.Y() < -9000) && pad->GetPadNum() != -1)
-                  std::cout << " AtPSASimple2::Analysis Warning! Wrong Coordinates for Pad : " << pad->GetPadNum()
-                            << std::endl;
+      if (gthreshold > 0 && charge < gthreshold) {
+         fValidThreshold = false;
+         LOG(debug) << "Invalid threshold with charge: " << charge << " and threshold: " << gthreshold;
+      }
+      if (fIsMaxFinder && (maxTime < 20 || maxTime > 500)) {
+         fValidThreshold = kFALSE;
+         LOG(debug) << "Peak is outside valid time window (20,500) TBs.";
+      }
 
-               // Tracking MC points
-               // if (mcPointsMap.size() > 0)
-               // TrackMCPoints(mcPointsMap, hit);
+      if (fValidThreshold && fValidDerivative) {
 
-               for (Int_t iTb = 0; iTb < fNumTbs; iTb++)
-                  mesh[iTb] += floatADC[iTb];
+         // Sum only if Hit is valid - We only sum once (iPeak==0) to account for the
+         // whole spectrum.
+         if (iPeak == 0)
+            ws.fQEventTot += QHitTot;
 
-            } // Valid Threshold
-         }    // Peak Loop
+         XYZPoint HitPos(pos.X(), pos.Y(), zPos);
+         ws.fHits.push_back({PadNum, HitPos, charge, maxAdcIdx, TBCorr, timemax, QHitTot});
 
-         //    #pragma omp ordered
-         // if(fValidThreshold && fValidBuff)
-         // PadMultiplicity.insert(std::pair<Int_t,Int_t>(PadNum,PadHitNum));
+         ws.fRho2 += HitPos.Mag2();
+         ws.fRhoMean += HitPos.Rho();
 
-         //#pragma omp ordered
-         PadMultiplicity.insert(std::pair<Int_t, Int_t>(pad->GetPadNum(), 1));
+         // Tracking MC points
+         // if (mcPointsMap.size() > 0)
+         // TrackMCPoints(mcPointsMap, hit);
 
-      } // if Valid Num Peaks
-   }    // Pad Loop
+         for (Int_t iTb = 0; iTb < fNumTbs; iTb++)
+            ws.fMesh[iTb] += floatADC[iTb];
 
-   // RhoVariance = Rho2 - (pow(RhoMean, 2) / (event->GetNumHits()));
-   RhoVariance = Rho2 - (event->GetNumHits() * pow((RhoMean / event->GetNumHits()), 2));
+      } // Valid Threshold
+   }    // Peak Loop
 
-   for (Int_t iTb = 0; iTb < fNumTbs; iTb++)
-      event->SetMeshSignal(iTb, mesh[iTb]);
-   event->SortHitArrayTime();
-   event->SetMultiplicityMap(PadMultiplicity);
-   event->SetRhoVariance(RhoVariance);
-   event->SetEventCharge(QEventTot);
+   ws.fPadsWithPeaks.push_back(PadNum);
 }
 
 void AtPSASimple2::SetBaseCorrection(Bool_t value)
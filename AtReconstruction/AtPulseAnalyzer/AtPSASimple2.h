@@ -4,13 +4,19 @@
 #include "AtCalibration.h" // for AtCalibration
 #include "AtPSA.h"
 
-#include <Rtypes.h>  // for Bool_t, THashConsistencyHolder, ClassDefOverride
-#include <TString.h> // for TString
+#include <Math/Point3D.h> // for XYZPoint
+#include <Rtypes.h>       // for Bool_t, THashConsistencyHolder, ClassDefOverride
+#include <TString.h>      // for TString
 
+#include <array>
+#include <cstddef>
 #include <memory> // for make_unique, unique_ptr
+#include <vector>
 
 class AtEvent;
+class AtPad;
 class AtRawEvent;
+class TSpectrum;
 class TBuffer;
 class TClass;
 class TMemberInspector;
@@ -18,6 +24,36 @@ class TMemberInspector;
 class [[deprecated("Use AtPSASpectrum or AtPSAMax instead")]] AtPSASimple2 : public AtPSA
 {
 private:
+   // Everything needed to create a hit, so hits found on different threads can be added in pad order
+   struct HitInfo {
+      Int_t fPadNum;
+      ROOT::Math::XYZPoint fPosition;
+      Double_t fCharge;
+      Int_t fTimeStamp;
+      Double_t fTimeStampCorr;
+      Double_t fTimeStampCorrInter;
+      Double_t fTraceIntegral;
+   };
+
+   // Reusable scratch space and results for the pads processed by one thread
+   struct Workspace {
+      std::unique_ptr<TSpectrum> fPeakFinder;
+      std::unique_ptr<TSpectrum> fBackground;
+
+      std::vector<HitInfo> fHits;
+      std::vector<Int_t> fPadsWithPeaks;
+      std::array<Float_t, 512> fMesh{};
+      Double_t fQEventTot{0};
+      Double_t fRhoMean{0};
+      Double_t fRho2{0};
+
+      Workspace();
+      Workspace(const Workspace &) : Workspace() {}
+      Workspace &operator=(const Workspace &) { return *this; }
+      ~Workspace();
+      void Reset();
+   };
+
    AtCalibration fCalibration;
 
    Bool_t fBackGroundSuppression{false};
@@ -27,6 +63,9 @@ private:
    Bool_t fIsBaseCorr{false};
    Bool_t fIsTimeCorr{false};
 
+   Int_t fNumThreads{1};
+   std::vector<Workspace> fWorkspaces; //!
+
 public:
    void Analyze(AtRawEvent * rawEvent, AtEvent * event) override;
    std::unique_ptr<AtPSA> Clone() override { return std::make_unique<AtPSASimple2>(*this); }
@@ -39,8 +78,15 @@ public:
    void SetMaxFinder();
    void SetBaseCorrection(Bool_t value);
    void SetTimeCorrection(Bool_t value);
+   /// Number of threads to split the pads of an event over. Requires ROOT::EnableThreadSafety().
+   void SetNumThreads(Int_t numThreads) { fNumThreads = numThreads; }
+
+private:
+   void AnalyzePads(const AtRawEvent *rawEvent, std::size_t begin, std::size_t end, Workspace &ws);
+   void AnalyzePad(const AtPad &pad, Workspace &ws);
 
-   ClassDefOverride(AtPSASimple2, 2)
+public:
+   ClassDefOverride(AtPSASimple2, 3)
 };
 
 #endif
@@ -126,6 +126,9 @@ void AtRansacTask::Exec(Option_t *opt)
    ransac.SetMinHitsPattern(fMinHitsLine);
    ransac.SetNumIterations(fNumItera);
    ransac.SetChargeThreshold(fChargeThres);
+   ransac.SetNumThreads(fNumThreads);
+   ransac.SetConfidence(fConfidence);
+   ransac.SetPreemptiveHits(fPreemptiveHits);
    fPatternEventArray.Delete();
    auto patternEvent = ransac.Solve(fEvent);
    new (fPatternEventArray[0]) AtPatternEvent(patternEvent);
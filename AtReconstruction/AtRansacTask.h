@@ -32,6 +32,9 @@ private:
    Int_t fRANSACAlg{0};
    Int_t fRandSamplMode{0};
    Double_t fChargeThres{-1};
+   Int_t fNumThreads{1};
+   Double_t fConfidence{0};
+   Int_t fPreemptiveHits{0};
 
 public:
    AtRansacTask();
@@ -49,13 +52,17 @@ public:
    void SetAlgorithm(Int_t val);
    void SetRanSamMode(Int_t mode);
    void SetChargeThreshold(Double_t value) { fChargeThres = value; }
+   void SetNumThreads(Int_t numThreads) { fNumThreads = numThreads; }
+   /// Stop sampling once this confidence is reached (see SampleConsensus::AtSampleConsensus::SetConfidence)
+   void SetConfidence(Double_t confidence) { fConfidence = confidence; }
+   void SetPreemptiveHits(Int_t nHits) { fPreemptiveHits = nHits; }
    void SetInputBranchName(TString inputName);
    void SetOutputBranchName(TString outputName);
 
    virtual InitStatus Init() override;
    virtual void Exec(Option_t *opt) override;
 
-   ClassDefOverride(AtRansacTask, 2);
+   ClassDefOverride(AtRansacTask, 3);
 };
 
 #endif
@@ -0,0 +1,86 @@
+#include "AtRawEventCompressTask.h"
+
+#include "AtCompressedRawEvent.h"
+#include "AtRawEvent.h"
+
+#include <FairLogger.h>
+#include <FairRootManager.h>
+#include <FairTask.h>
+
+#include <TClonesArray.h>
+#include <TObject.h>
+
+ClassImp(AtRawEventCompressTask);
+ClassImp(AtRawEventDecompressTask);
+
+namespace {
+TClonesArray *GetInputArray(const TString &branchName)
+{
+   FairRootManager *ioMan = FairRootManager::Instance();
+   if (ioMan == nullptr) {
+      LOG(fatal) << "Cannot find RootManager!";
+      return nullptr;
+   }
+
+   auto array = dynamic_cast<TClonesArray *>(ioMan->GetObject(branchName));
+   if (array == nullptr)
+      LOG(fatal) << "Cannot find input array in branch " << branchName << "!";
+   return array;
+}
+} // namespace
+
+AtRawEventCompressTask::AtRawEventCompressTask()
+   : FairTask("AtRawEventCompressTask"), fOutputEventArray("AtCompressedRawEvent", 1)
+{
+}
+
+InitStatus AtRawEventCompressTask::Init()
+{
+   fInputEventArray = GetInputArray(fInputBranchName);
+   if (fInputEventArray == nullptr)
+      return kFATAL;
+
+   FairRootManager::Instance()->Register(fOutputBranchName, "AtTPC", &fOutputEventArray, fIsPersistent);
+   return kSUCCESS;
+}
+
+void AtRawEventCompressTask::Exec(Option_t *opt)
+{
+   fOutputEventArray.Clear("C");
+   if (fInputEventArray->GetEntriesFast() == 0)
+      return;
+
+   auto rawEvent = dynamic_cast<AtRawEvent *>(fInputEventArray->At(0));
+   auto compressedEvent = dynamic_cast<AtCompressedRawEvent *>(fOutputEventArray.ConstructedAt(0));
+   compressedEvent->Compress(*rawEvent, fThreshold, fWindow, fAdcScale);
+
+   if (auto numSaturated = compressedEvent->GetNumSaturated(); numSaturated > 0)
+      LOG(warn) << "Saturated " << numSaturated << " samples outside of the int16 range compressing event "
+                << rawEvent->GetEventID();
+}
+
+AtRawEventDecompressTask::AtRawEventDecompressTask()
+   : FairTask("AtRawEventDecompressTask"), fOutputEventArray("AtRawEvent", 1)
+{
+}
+
+InitStatus AtRawEventDecompressTask::Init()
+{
+   fInputEventArray = GetInputArray(fInputBranchName);
+   if (fInputEventArray == nullptr)
+      return kFATAL;
+
+   FairRootManager::Instance()->Register(fOutputBranchName, "AtTPC", &fOutputEventArray, fIsPersistent);
+   return kSUCCESS;
+}
+
+void AtRawEventDecompressTask::Exec(Option_t *opt)
+{
+   fOutputEventArray.Clear("C");
+   if (fInputEventArray->GetEntriesFast() == 0)
+      return;
+
+   auto compressedEvent = dynamic_cast<AtCompressedRawEvent *>(fInputEventArray->At(0));
+   auto rawEvent = dynamic_cast<AtRawEvent *>(fOutputEventArray.ConstructedAt(0));
+   compressedEvent->FillRawEvent(*rawEvent);
+}
@@ -0,0 +1,72 @@
+/*
+ * Tasks for writing raw events in the compact AtCompressedRawEvent format and reading them back.
+ *
+ * AtRawEventCompressTask takes an AtRawEvent branch and writes a (persistent) AtCompressedRawEvent branch.
+ * Use it instead of making the AtRawEvent branch persistent to reduce the size of raw event files.
+ * AtRawEventDecompressTask rebuilds the AtRawEvent branch (not persistent by default) from such a file.
+ */
+#ifndef ATRAWEVENTCOMPRESSTASK_H
+#define ATRAWEVENTCOMPRESSTASK_H
+
+#include <FairTask.h>
+
+#include <Rtypes.h>
+#include <TClonesArray.h>
+#include <TString.h>
+
+class TBuffer;
+class TClass;
+class TMemberInspector;
+
+class AtRawEventCompressTask : public FairTask {
+private:
+   TString fInputBranchName{"AtRawEvent"};
+   TString fOutputBranchName{"AtCompressedRawEvent"};
+   Bool_t fIsPersistent{true};
+
+   Double_t fThreshold{10}; //< Keep samples above this value (in the calibrated trace if pedestal subtracted)
+   Int_t fWindow{5};        //< Number of neighboring samples kept on each side of a sample above threshold
+   Double_t fAdcScale{1};   //< Calibrated trace is stored with a precision of 1/fAdcScale
+
+   TClonesArray *fInputEventArray{nullptr};
+   TClonesArray fOutputEventArray;
+
+public:
+   AtRawEventCompressTask();
+
+   void SetInputBranch(TString name) { fInputBranchName = name; }
+   void SetOutputBranch(TString name) { fOutputBranchName = name; }
+   void SetPersistence(Bool_t value) { fIsPersistent = value; }
+   void SetThreshold(Double_t threshold) { fThreshold = threshold; }
+   void SetWindow(Int_t window) { fWindow = window; }
+   void SetAdcScale(Double_t scale) { fAdcScale = scale; }
+
+   virtual InitStatus Init() override;
+   virtual void Exec(Option_t *opt) override;
+
+   ClassDefOverride(AtRawEventCompressTask, 1);
+};
+
+class AtRawEventDecompressTask : public FairTask {
+private:
+   TString fInputBranchName{"AtCompressedRawEvent"};
+   TString fOutputBranchName{"AtRawEvent"};
+   Bool_t fIsPersistent{false};
+
+   TClonesArray *fInputEventArray{nullptr};
+   TClonesArray fOutputEventArray;
+
+public:
+   AtRawEventDecompressTask();
+
+   void SetInputBranch(TString name) { fInputBranchName = name; }
+   void SetOutputBranch(TString name) { fOutputBranchName = name; }
+   void SetPersistence(Bool_t value) { fIsPersistent = value; }
+
+   virtual InitStatus Init() override;
+   virtual void Exec(Option_t *opt) override;
+
+   ClassDefOverride(AtRawEventDecompressTask, 1);
+};
+
+#endif //#ifndef ATRAWEVENTCOMPRESSTASK_H
@@ -40,7 +40,10 @@
 #pragma link C++ class AtPRAtask + ;
 #pragma link C++ class AtRansacTask + ;
 #pragma link C++ class AtDataReductionTask + ;
+#pragma link C++ class AtRawEventCompressTask + ;
+#pragma link C++ class AtRawEventDecompressTask + ;
 #pragma link C++ class AtSpaceChargeCorrectionTask + ;
 #pragma link C++ class AtFilterTask + ;
+#pragma link C++ class AtParallelRecoTask - !;
 
 #endif
@@ -3,7 +3,6 @@
 #include <FairLogger.h>
 #include <FairTask.h>
 
-#include <Math/ParamFunctor.h>
 #include <TClonesArray.h>
 #include <TCollection.h>
 #include <TFile.h>
@@ -16,9 +15,8 @@
 #include <FairRootManager.h>
 
 #include <TCutG.h>
-#include <TF1.h>
-#include <TGraph.h>
 #include <TKey.h>
+#include <TTree.h>
 #include <TTreeReader.h>
 #include <TTreeReaderValue.h>
 
@@ -27,6 +25,7 @@
 #include <algorithm>
 #include <cmath>
 #include <iostream>
+#include <numeric>
 
 ClassImp(AtMergeTask);
 
@@ -47,8 +46,8 @@ AtMergeTask::AtMergeTask() : fLogger(FairLogger::GetLogger()), fS800CalcBr(new S
 
 AtMergeTask::~AtMergeTask()
 {
-   fS800TsGraph->Delete();
-   fS800TsFunc->Delete();
+   fS800CalcValue.reset();
+   fS800Reader.reset();
    fS800CalcBr->Delete();
    fRawEventArray->Delete();
    delete fS800file;
@@ -262,10 +261,10 @@ InitStatus AtMergeTask::Init()
    TTreeReader reader1("caltree", fS800file);
    TTreeReaderValue<Long64_t> ts(reader1, "fts");
 
+   fS800Ts.clear();
    while (reader1.Next()) {
       fS800Ts.push_back((Long64_t)*ts);
       // fS800Ts.push_back((Long64_t) *ts - fTsDelta);//special for run180 e18027
-      fS800Evt.push_back((Double_t)fTsEvtS800Size);
       if (fTsEvtS800Size < 20)
          std::cout << "Ts S800 " << fS800Ts.at(fTsEvtS800Size) << std::endl;
       fTsEvtS800Size++;
@@ -273,24 +272,23 @@ InitStatus AtMergeTask::Init()
    // ioMan -> RegisterAny("s800cal", fS800CalcBr, fIsPersistence);
    ioMan->Register("s800cal", "S800", fS800CalcBr, fIsPersistence);
 
-   vector<Double_t> S800_ts(fS800Ts.begin(), fS800Ts.end());
-   // auto c1 = new TCanvas("c1", "c1", 800, 800);
-   // gROOT->SetBatch(kTRUE);//kTRUE not display the plots
-   fS800TsGraph =
-      new TGraph(fTsEvtS800Size, &S800_ts[0], &fS800Evt[0]); // fTsEvtS800Size instead of 80 (just for the test file)
-   // make a function of S800Evt vs S800TS, used then to search the S800 matching TS only among few S800 events, faster
-   // than looping on all the events.
-   fS800TsFunc = new TF1(
-      "fS800TsFunc", [&](double *x, double *) { return fS800TsGraph->Eval(x[0]); }, 0, S800_ts.back(), 0);
-   // c1->cd();
-   // fS800TsGraph->Draw("AL");
-   // fS800TsFunc->Draw("same");
-
-   // auto c2 = new TCanvas("c2", "c2", 800, 800);
-   // c2->cd();
-   // gROOT->ProcessLine(".x "+fcutPIDFile);//
-   // fcutPID = (TCutG*)gROOT->GetListOfSpecials()->FindObject("CUTG");
-   // fcutPID->SetName("fcutPID");
+   // Sort the S800 entries by timestamp so the entries matching an AT-TPC event can be found with a binary search.
+   // They are usually already in order, in which case this is linear.
+   fS800TsOrder.resize(fS800Ts.size());
+   std::iota(fS800TsOrder.begin(), fS800TsOrder.end(), 0);
+   std::stable_sort(fS800TsOrder.begin(), fS800TsOrder.end(),
+                    [this](Long64_t a, Long64_t b) { return fS800Ts[a] < fS800Ts[b]; });
+   fS800TsSearchStart = 0;
+
+   // Matched entries are read in increasing order, so a single reader with a read-ahead cache is used for all of them
+   auto *calTree = dynamic_cast<TTree *>(fS800file->Get("caltree"));
+   if (calTree == nullptr) {
+      LOG(error) << "Cannot find caltree in " << fS800File;
+      return kERROR;
+   }
+   calTree->SetCacheSize(fS800CacheSize);
+   fS800Reader = std::make_unique<TTreeReader>(calTree);
+   fS800CalcValue = std::make_unique<TTreeReaderValue<S800Calc>>(*fS800Reader, "s800calc");
 
    for (auto &w : fcutPID1File) {
       TFile f(w);
@@ -349,10 +347,44 @@ fLogger -> Fatal(MESSAGE_ORIGIN, "AtDigiPar not found!!");
 }
 */
 
-void AtMergeTask::Exec(Option_t *opt)
+/**
+ * Find the first S800 entry whose timestamp (shifted by fTsDelta) is within the glom of the AT-TPC timestamp,
+ * skipping entries within the glom of the entry before them. Returns -1 if there is no match.
+ *
+ * The AT-TPC events are usually in time order, so the search continues from where the last one started and only
+ * falls back to a binary search when the timestamp goes backwards.
+ */
+Long64_t AtMergeTask::FindS800Match(Long64_t AtTPCTs)
 {
-   // if ( fS800CalcBr == NULL ) std::cout<<"fS800CalcBr NULL"<<std::endl;
+   auto tsLess = [this](Long64_t entry, Double_t ts) { return fS800Ts[entry] < ts; };
+   Double_t minTs = AtTPCTs - fTsDelta - fGlom;
+   Double_t maxTs = AtTPCTs - fTsDelta + fGlom;
+
+   auto start = fS800TsOrder.begin() + fS800TsSearchStart;
+   if (start != fS800TsOrder.begin() && !tsLess(*(start - 1), minTs))
+      start = std::lower_bound(fS800TsOrder.begin(), start, minTs, tsLess);
+   else
+      while (start != fS800TsOrder.end() && tsLess(*start, minTs))
+         ++start;
+   fS800TsSearchStart = start - fS800TsOrder.begin();
+
+   Long64_t match = -1;
+   for (auto it = start; it != fS800TsOrder.end() && fS800Ts[*it] <= maxTs; ++it) {
+      auto i = *it;
+      // fTsDelta constant offset likely from the length of the sync signal between S800 and At-TPC
+      if (!isInGlom(fS800Ts[i] + fTsDelta, AtTPCTs) || (match >= 0 && i > match))
+         continue;
+      if (i > 0 && isInGlom(fS800Ts[i - 1], fS800Ts[i]))
+         std::cout << " -- Warning -- Timestamp of consecutive entries from S800 root file within the glom"
+                   << std::endl;
+      else
+         match = i;
+   }
+   return match;
+}
 
+void AtMergeTask::Exec(Option_t *opt)
+{
    fS800CalcBr->Clear();
 
    if (fRawEventArray->GetEntriesFast() == 0)
@@ -360,58 +392,23 @@ void AtMergeTask::Exec(Option_t *opt)
 
    auto *rawEvent = dynamic_cast<AtRawEvent *>(fRawEventArray->At(0));
    Long64_t AtTPCTs = rawEvent->GetTimestamp();
-   int minj = 0, maxj = 0;
-   Double_t S800EvtMatch = -1;
-   minj = (int)fS800TsFunc->Eval(AtTPCTs) - fEvtDelta; // define the AtTPC entries range where the matching timestamp
-                                                       // should be, to not loop over all the AtTPC entries.
-   maxj = (int)fS800TsFunc->Eval(AtTPCTs) + fEvtDelta;
-
    std::cout << " TS AtTPC " << AtTPCTs << std::endl;
 
-   for (int i = minj; i < maxj; i++) {
-      if (i >= 0 && i < fTsEvtS800Size) {
-         if (i > 0 && isInGlom(fS800Ts.at(i - 1), fS800Ts.at(i)))
-            std::cout << " -- Warning -- Timestamp of consecutive entries from S800 root file within the glom"
-                      << std::endl;
-         else {
-            // Is there a way to check that with the At-TPC "event by event" processing?
-            /*if(isInGlom(TsEvtAtTPC.at(i-1),TsEvtAtTPC.at(i)) )
-            {
-            cout<<" -- Warning -- Timestamp of consecutive entries from AtTPC root file within the glom"<<endl;
-          }
-          else*/
-            if (isInGlom(fS800Ts.at(i) + fTsDelta, AtTPCTs)) { // fTsDelta constant offset likely from the length of the
-                                                               // sync signal between S800 and At-TPC
-               // if(isInGlom(fS800Ts.at(i),AtTPCTs) ){//special run180
-               S800EvtMatch = (int)fS800Evt.at(i);
-               std::cout << " in glom " << minj << " " << maxj << " " << i << " " << fS800Ts.at(i) << " " << AtTPCTs
-                         << " " << S800EvtMatch << " " << fS800TsFunc->Eval(AtTPCTs) << " " << AtTPCTs - fS800Ts.at(i)
-                         << std::endl;
-               fEvtMerged++;
-               break;
-            } else
-               S800EvtMatch = -1;
-            // std::cout<<" NOT in glom "<<minj<<" "<<maxj<<" "<<i<<" "<<fS800Ts.at(i)<<" "<<AtTPCTs<<"
-            // "<<fS800Ts.at(i)-AtTPCTs<<" "<<S800EvtMatch<<std::endl;
-         }
-      }
-   }
-
-   if (S800EvtMatch < 0)
+   auto S800EvtMatch = FindS800Match(AtTPCTs);
+   if (S800EvtMatch < 0) {
       std::cout << "NO TS MAtCHING          !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!" << std::endl;
+      return;
+   }
 
-   if (S800EvtMatch > 0) {
-      TTreeReader reader2("caltree", fS800file);
-      TTreeReaderValue<S800Calc> *readerValueS800Calc = nullptr;
-      readerValueS800Calc = new TTreeReaderValue<S800Calc>(reader2, "s800calc");
-
-      reader2.SetEntry(S800EvtMatch);
+   std::cout << " in glom " << S800EvtMatch << " " << fS800Ts.at(S800EvtMatch) << " " << AtTPCTs << " "
+             << AtTPCTs - fS800Ts.at(S800EvtMatch) << std::endl;
+   fEvtMerged++;
 
-      *fS800CalcBr = (S800Calc)*readerValueS800Calc->Get();
+   fS800Reader->SetEntry(S800EvtMatch);
+   *fS800CalcBr = *fS800CalcValue->Get();
 
-      Bool_t isIn = kFALSE;
-      isIn = isInPID(fS800CalcBr);
-      fS800CalcBr->SetIsInCut(isIn);
-      rawEvent->SetIsExtGate(isIn);
-   }
+   Bool_t isIn = kFALSE;
+   isIn = isInPID(fS800CalcBr);
+   fS800CalcBr->SetIsInCut(isIn);
+   rawEvent->SetIsExtGate(isIn);
 }
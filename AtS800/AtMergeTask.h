@@ -6,6 +6,8 @@
 // FAIRROOT classes
 #include <FairTask.h>
 
+#include <cstddef>
+#include <memory>
 #include <vector>
 
 // AtTPCROOT classes
@@ -16,10 +18,11 @@ class TBuffer;
 class TClass;
 class TClonesArray;
 class TCutG;
-class TF1;
 class TFile;
-class TGraph;
 class TMemberInspector;
+class TTreeReader;
+template <typename T>
+class TTreeReaderValue;
 
 class AtMergeTask : public FairTask {
 
@@ -30,7 +33,10 @@ public:
    void SetPersistence(Bool_t value = kTRUE);
    void SetS800File(TString file);
    void SetGlom(Double_t glom);
+   /// Unused, the matching S800 entries are found directly from the sorted timestamps
    void SetOptiEvtDelta(Int_t EvtDelta);
+   /// Size in bytes of the read-ahead cache used to read the S800 tree
+   void SetS800CacheSize(Long64_t size) { fS800CacheSize = size; }
    void SetPID1cut(TString file);
    void SetPID2cut(TString file);
    void SetPID3cut(TString file);
@@ -60,18 +66,20 @@ private:
    TClonesArray *fRawEventArray{};
    S800Calc *fS800CalcBr;
    TFile *fS800file{};
+   std::unique_ptr<TTreeReader> fS800Reader;                  //! Reader of the S800 caltree
+   std::unique_ptr<TTreeReaderValue<S800Calc>> fS800CalcValue; //!
+   Long64_t fS800CacheSize{10000000};
 
    Int_t fTsEvtS800Size{}, fEvtMerged{}, fEvtDelta{5}, fTsDelta{1272};
    TString fS800File;
-   std::vector<Long64_t> fS800Ts;
-   std::vector<Double_t> fS800Evt;
+   std::vector<Long64_t> fS800Ts;      //< Timestamp of each S800 entry
+   std::vector<Long64_t> fS800TsOrder; //< S800 entries sorted by timestamp
+   std::size_t fS800TsSearchStart{0};  //< Position in fS800TsOrder where the last search started
    std::vector<Double_t> fParameters;
    std::vector<Double_t> fTofObjCorr;
    std::vector<Double_t> fMTDCObjRange;
    std::vector<Double_t> fMTDCXfRange;
 
-   TF1 *fS800TsFunc{};
-   // TF1 *fOptiFit;
    Double_t fGlom{2};
 
    std::vector<TCutG *> fcutPID1;
@@ -86,9 +94,9 @@ private:
    Bool_t fSetCut2{false};
    Bool_t fSetCut3{false};
 
-   TGraph *fS800TsGraph{};
+   Long64_t FindS800Match(Long64_t AtTPCTs);
 
-   ClassDef(AtMergeTask, 1);
+   ClassDef(AtMergeTask, 2);
 };
 
 #endif
@@ -7,6 +7,8 @@
 #include <cmath>
 #include <fstream> // IWYU pragma: keep
 #include <iostream>
+#include <iterator>
+#include <utility>
 
 ClassImp(AtTools::AtELossManager);
 
@@ -62,11 +64,22 @@ AtTools::AtELossManager::AtELossManager(std::string Eloss_file, Double_t Mass)
       IonMass = Mass; // In MeV/c^2
       c = 29.9792458; // Speed of light in cm/ns.
       EvD = std::make_shared<TGraph>();
+      BuildRangeTables();
    }
 }
 
 AtTools::AtELossManager::~AtELossManager() = default;
 
+/// Index p of the table point with IonEnergy[p] <= energy < IonEnergy[p+1], or -1 if out of range
+Int_t AtTools::AtELossManager::FindEnergyBin(Double_t energy) const
+{
+   auto end = IonEnergy.begin() + std::min<std::size_t>(std::max(points, 0), IonEnergy.size());
+   auto it = std::upper_bound(IonEnergy.begin(), end, energy);
+   if (it == IonEnergy.begin() || it == end)
+      return -1;
+   return std::distance(IonEnergy.begin(), it) - 1;
+}
+
 Double_t AtTools::AtELossManager::GetEnergyLossLinear(Double_t energy, Double_t distance)
 {
 
@@ -75,15 +88,10 @@ Double_t AtTools::AtELossManager::GetEnergyLossLinear(Double_t energy, Double_t
       // Look for two points for which the initial energy lays in between.  This for-loop should find the points
       // unless there was a big jump from the energy used in the last point and the energy used now.
 
-      for (int p = 0; p < points - 1; p++) {
-
-         if (energy >= IonEnergy[p] && energy < IonEnergy[p + 1]) {
-
-            i = p + 1;
-            last_point = p;
-
-            break;
-         }
+      auto p = FindEnergyBin(energy);
+      if (p >= 0) {
+         i = p + 1;
+         last_point = p;
       }
 
       // If after this two loop i is still -1 it means the energy was out of range.
@@ -143,15 +151,10 @@ double AtTools::AtELossManager::GetEnergyLoss(double energy /*MeV*/, double dist
    // unless there was a big jump from the energy used in the
    // last point and the energy used now.
 
-   for (int p = 0; p < points - 1; p++) {
-
-      if (energy >= IonEnergy[p] && energy < IonEnergy[p + 1]) {
-
-         i = p + 1;
-         last_point = p;
-
-         break;
-      }
+   auto p = FindEnergyBin(energy);
+   if (p >= 0) {
+      i = p + 1;
+      last_point = p;
    }
    // If after this two loop i is still -1 it means the energy was out of range.
 
@@ -219,6 +222,13 @@ double AtTools::AtELossManager::GetEnergyLoss(double energy /*MeV*/, double dist
 Double_t AtTools::AtELossManager::GetInitialEnergy(Double_t FinalEnergy /*MeV*/, Double_t PathLength /*cm*/ /*dist*/,
                                                    Double_t StepSize /*cm*/)
 {
+   if (UseRangeTables()) {
+      auto range = GetRange(FinalEnergy);
+      auto energy = GetEnergyFromRange(range + PathLength);
+      if (range >= 0 && energy >= 0)
+         return energy;
+   }
+
    Double_t Energy = FinalEnergy;
    int Steps = (int)floor(PathLength / StepSize);
    last_point = 0;
@@ -248,6 +258,11 @@ Double_t AtTools::AtELossManager::GetInitialEnergy(Double_t FinalEnergy /*MeV*/,
 Double_t AtTools::AtELossManager::GetFinalEnergy(Double_t InitialEnergy /*MeV*/, Double_t PathLength /*cm*/,
                                                  Double_t StepSize /*cm*/)
 {
+   if (UseRangeTables()) {
+      auto range = GetRange(InitialEnergy);
+      if (range >= PathLength)
+         return GetEnergyFromRange(range - PathLength);
+   }
 
    Double_t Energy = InitialEnergy;
    int Steps = (int)floor(PathLength / StepSize);
@@ -281,6 +296,12 @@ Double_t AtTools::AtELossManager::GetFinalEnergy(Double_t InitialEnergy /*MeV*/,
 
 Double_t AtTools::AtELossManager::GetDistance(Double_t InitialE, Double_t FinalE, Double_t StepSize)
 {
+   if (UseRangeTables()) {
+      auto initialRange = GetRange(InitialE);
+      auto finalRange = GetRange(FinalE);
+      if (initialRange >= 0 && finalRange >= 0)
+         return initialRange - finalRange;
+   }
 
    Double_t dist = 0;
    Double_t E = 0, Elast = 0;
@@ -387,6 +408,14 @@ Double_t AtTools::AtELossManager::LoadRange(Float_t energy1)
 
 Double_t AtTools::AtELossManager::GetTimeOfFlight(Double_t InitialEnergy, Double_t PathLength, Double_t StepSize)
 {
+   if (UseRangeTables() && !fTOFTable.empty()) {
+      auto range = GetRange(InitialEnergy);
+      if (range >= PathLength) {
+         auto finalEnergy = GetEnergyFromRange(range - PathLength);
+         return InterpolateLogE(fTOFTable, InitialEnergy) - InterpolateLogE(fTOFTable, finalEnergy);
+      }
+   }
+
    Double_t TOF = 0;
    Double_t Kn = InitialEnergy;
    int Steps = (int)(PathLength / StepSize);
@@ -412,6 +441,156 @@ Double_t AtTools::AtELossManager::GetTimeOfFlight(Double_t InitialEnergy, Double
 void AtTools::AtELossManager::SetIonMass(Double_t Mass)
 {
    IonMass = Mass;
+   if (!fRangeTable.empty())
+      BuildRangeTables(fRangeTable.size());
+}
+
+/**
+ * The range at each point of the grid is the integral of dE/S(E) from the first point, where S is the
+ * stopping power from GetEnergyLoss, integrated with Simpson's rule between neighboring points. The time of
+ * flight uses the integrand dE/(S(E)v(E)). The inverse, E(range), is found from fRangeIndex, which stores for
+ * a uniform grid in range the point of fRangeTable to start the interpolation from.
+ */
+void AtTools::AtELossManager::BuildRangeTables(Int_t numPoints)
+{
+   fRangeTable.clear();
+   fTOFTable.clear();
+   fRangeIndex.clear();
+
+   // GetEnergyLoss interpolates using the point after the bin, so the last bin of the table cannot be used
+   Int_t numValid = 1;
+   while (numValid < std::min<Int_t>(points, IonEnergy.size()) && IonEnergy[numValid] > IonEnergy[numValid - 1])
+      ++numValid;
+   if (numValid < 4 || numPoints < 2 || IonEnergy[0] <= 0) {
+      std::cout << "*** EnergyLoss Error: Not enough points to build range tables."
+                << "\n";
+      return;
+   }
+   Double_t eMin = std::max(IonEnergy[0], 0.01);
+   Double_t eMax = IonEnergy[numValid - 2];
+   fLogEMin = std::log(eMin);
+   fDeltaLogE = (std::log(eMax) - fLogEMin) / numPoints; // The last point is one step below eMax
+
+   auto stoppingPower = [this, eMax](Double_t energy) { return GetEnergyLoss(std::min(energy, eMax), 1.0); };
+   auto velocity = [this](Double_t energy) { return std::sqrt(2 * energy / IonMass) * c; };
+
+   std::vector<Double_t> range(numPoints, 0);
+   std::vector<Double_t> tof(numPoints, 0);
+   Double_t e0 = eMin;
+   Double_t s0 = stoppingPower(e0);
+   for (Int_t k = 1; k < numPoints; ++k) {
+      Double_t e2 = std::exp(fLogEMin + k * fDeltaLogE);
+      Double_t e1 = (e0 + e2) / 2;
+      Double_t s1 = stoppingPower(e1);
+      Double_t s2 = stoppingPower(e2);
+      if (s0 <= 0 || s1 <= 0 || s2 <= 0) {
+         std::cout << "*** EnergyLoss Error: Non-positive stopping power at " << e2 << " MeV, range tables not built."
+                   << "\n";
+         return;
+      }
+
+      Double_t h = (e2 - e0) / 6;
+      range[k] = range[k - 1] + h * (1 / s0 + 4 / s1 + 1 / s2);
+      if (IonMass > 0)
+         tof[k] = tof[k - 1] + h * (1 / (s0 * velocity(e0)) + 4 / (s1 * velocity(e1)) + 1 / (s2 * velocity(e2)));
+      e0 = e2;
+      s0 = s2;
+   }
+
+   fDeltaRange = range.back() / (numPoints - 1);
+   fRangeIndex.resize(numPoints);
+   Int_t k = 0;
+   for (Int_t j = 0; j < numPoints; ++j) {
+      while (k + 2 < numPoints && range[k + 1] <= j * fDeltaRange)
+         ++k;
+      fRangeIndex[j] = k;
+   }
+
+   fRangeTable = std::move(range);
+   if (IonMass > 0)
+      fTOFTable = std::move(tof);
+
+   CheckRangeTables();
+}
+
+Double_t AtTools::AtELossManager::CheckRangeTables(Int_t numEnergies, Int_t numSteps, Double_t tolerance)
+{
+   if (fRangeTable.size() < 3 || numEnergies < 1 || numSteps < 1)
+      return -1;
+
+   // Stop one point above the start of the tables so every step stays within the stopping power table
+   Double_t finalEnergy = std::exp(fLogEMin + fDeltaLogE);
+   Double_t maxDiff = 0;
+   Double_t maxDiffEnergy = 0;
+   for (Int_t i = 0; i < numEnergies; ++i) {
+      Double_t x = 2 + (fRangeTable.size() - 3) * (i + 1.0) / numEnergies;
+      Double_t energy = std::exp(fLogEMin + x * fDeltaLogE);
+      Double_t distance = GetRange(energy) - GetRange(finalEnergy);
+      Double_t stepSize = distance / numSteps;
+
+      // Step through the stopping power (midpoint rule) until the energy drops below finalEnergy
+      Double_t stepDistance = 0;
+      Double_t stepTOF = 0;
+      Double_t E = energy;
+      Energy_in_range = true;
+      for (Int_t n = 0; E > finalEnergy && Energy_in_range && n < 2 * numSteps; ++n) {
+         Double_t midE = std::max(E - GetEnergyLoss(E, stepSize / 2), finalEnergy);
+         Double_t nextE = E - GetEnergyLoss(midE, stepSize);
+         Double_t fraction = nextE < finalEnergy ? (E - finalEnergy) / (E - nextE) : 1;
+         stepDistance += fraction * stepSize;
+         if (IonMass > 0)
+            stepTOF += fraction * stepSize / (std::sqrt(2 * midE / IonMass) * c);
+         E = nextE;
+      }
+
+      Double_t diff = E > finalEnergy || !Energy_in_range ? 1 : std::abs(distance / stepDistance - 1);
+      if (!fTOFTable.empty()) {
+         Double_t tof = InterpolateLogE(fTOFTable, energy) - InterpolateLogE(fTOFTable, finalEnergy);
+         diff = std::max(diff, std::abs(tof / stepTOF - 1));
+      }
+      if (!(diff <= maxDiff)) {
+         maxDiff = diff;
+         maxDiffEnergy = energy;
+      }
+   }
+   Energy_in_range = true;
+
+   if (!(maxDiff <= tolerance))
+      std::cout << "*** EnergyLoss Warning: Range tables differ from step integration by " << maxDiff * 100
+                << "% at " << maxDiffEnergy << " MeV."
+                << "\n";
+   return maxDiff;
+}
+
+Double_t AtTools::AtELossManager::InterpolateLogE(const std::vector<Double_t> &table, Double_t energy) const
+{
+   if (table.empty() || energy <= 0)
+      return -1;
+   Double_t x = (std::log(energy) - fLogEMin) / fDeltaLogE;
+   if (x < 0 || x > table.size() - 1)
+      return -1;
+
+   auto k = std::min<std::size_t>(x, table.size() - 2);
+   return table[k] + (x - k) * (table[k + 1] - table[k]);
+}
+
+Double_t AtTools::AtELossManager::GetRange(Double_t energy) const
+{
+   return InterpolateLogE(fRangeTable, energy);
+}
+
+Double_t AtTools::AtELossManager::GetEnergyFromRange(Double_t range) const
+{
+   if (fRangeTable.empty() || range < 0 || range > fRangeTable.back())
+      return -1;
+
+   std::size_t k = fRangeIndex[std::min<std::size_t>(range / fDeltaRange, fRangeIndex.size() - 1)];
+   while (k + 2 < fRangeTable.size() && fRangeTable[k + 1] <= range)
+      ++k;
+
+   // Interpolate linearly in log(E) between the points of the table
+   Double_t x = k + (range - fRangeTable[k]) / (fRangeTable[k + 1] - fRangeTable[k]);
+   return std::exp(fLogEMin + x * fDeltaLogE);
 }
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // Lookup Table Extension
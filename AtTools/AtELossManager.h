@@ -41,6 +41,26 @@ public:
    void PrintLookupTables();
    Double_t GetLookupEnergy(Double_t InitialEnergy, Double_t distance);
 
+   /**
+    * Build the range and time of flight tables on a grid of numPoints energies uniform in log(E). Once built,
+    * GetFinalEnergy, GetInitialEnergy, GetDistance and GetTimeOfFlight interpolate them instead of stepping
+    * through the stopping power (the step size is then ignored). Called by the constructor.
+    */
+   void BuildRangeTables(Int_t numPoints = 2000);
+   /// Use the range tables (default), or step through the stopping power to validate them
+   void SetUseRangeTables(Bool_t val) { fUseRangeTables = val; }
+   /// Distance (cm) needed to slow from energy (MeV) to the lowest energy of the table, or -1 if out of range
+   Double_t GetRange(Double_t energy) const;
+   /// Energy (MeV) with the passed range (cm), or -1 if out of range
+   Double_t GetEnergyFromRange(Double_t range) const;
+   /**
+    * Compare the range and time of flight tables to stepping through the stopping power for numEnergies
+    * energies spread over the tables, slowing down to the second point of the tables in about numSteps steps.
+    * Prints a warning if they differ by more than tolerance. Called by BuildRangeTables.
+    * @return The largest relative difference found, or -1 if the tables are not built.
+    */
+   Double_t CheckRangeTables(Int_t numEnergies = 20, Int_t numSteps = 1000, Double_t tolerance = 0.01);
+
 private:
    std::shared_ptr<TGraph> EvD;
 
@@ -67,7 +87,19 @@ private:
    Bool_t Energy_in_range{true};
    Bool_t GoodELossFile{false};
 
-   ClassDef(AtELossManager, 1)
+   Bool_t fUseRangeTables{true};
+   Double_t fLogEMin{};                  //< log(E) of the first point of the range tables
+   Double_t fDeltaLogE{};                //< Spacing of the range tables in log(E)
+   Double_t fDeltaRange{};               //< Spacing of fRangeIndex in range (cm)
+   std::vector<Double_t> fRangeTable;    //< Range (cm) at each energy of the log grid
+   std::vector<Double_t> fTOFTable;      //< Time (ns) to slow from each energy of the log grid to the first
+   std::vector<Int_t> fRangeIndex;       //< Last point of fRangeTable below each multiple of fDeltaRange
+
+   Int_t FindEnergyBin(Double_t energy) const;
+   Bool_t UseRangeTables() const { return fUseRangeTables && !fRangeTable.empty(); }
+   Double_t InterpolateLogE(const std::vector<Double_t> &table, Double_t energy) const;
+
+   ClassDef(AtELossManager, 2)
 };
 } // namespace AtTools
 
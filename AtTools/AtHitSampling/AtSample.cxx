@@ -76,7 +76,7 @@ std::vector<int> AtSample::sampleIndicesFromCDF(int N, std::vector<int> vetoed)
    double rmProb = 0;
    std::vector<int> sampledInd;
    while (sampledInd.size() < N) {
-      auto r = gRandom->Uniform();
+      auto r = Uniform();
 
       // Get the index i where CDF[i] >= r and CDF[i-1] < r
       int hitInd = getIndexFromCDF(r, rmProb, vetoed);
@@ -98,6 +98,12 @@ std::vector<int> AtSample::sampleIndicesFromCDF(int N, std::vector<int> vetoed)
    return sampledInd;
 }
 
+/// Uniform random number from fRandom, or gRandom if it is not set
+double AtSample::Uniform()
+{
+   return fRandom != nullptr ? fRandom->Uniform() : gRandom->Uniform();
+}
+
 /**
  * Fill the cumulitive distribution function to sample using the marginal PDFs returned by the
  * function PDF(const AtHit &hit) from every entry in the vector fHits.
@@ -7,6 +7,7 @@
 #include <vector>
 
 class AtHit;
+class TRandom;
 
 /**
  * @brief Classes for sampling AtHits.
@@ -36,6 +37,7 @@ protected:
    const std::vector<AtHit> *fHits; //< Hits to sample from
    std::vector<double> fCDF;        //< Cummulative distribution function for hits
    bool fWithReplacement{false};    //< If we should sample with replacement
+   TRandom *fRandom{nullptr};       //< Generator to sample with (not owned). Uses gRandom if null.
 
 public:
    virtual ~AtSample() = default;
@@ -46,6 +48,8 @@ public:
    virtual void SetHitsToSample(const std::vector<AtHit> *hits) = 0;
 
    void SetSampleWithReplacement(bool val) { fWithReplacement = val; }
+   /// Sample using **rand** instead of gRandom, so samplers on different threads do not share a generator
+   void SetRandom(TRandom *rand) { fRandom = rand; }
 
 protected:
    /**
@@ -58,6 +62,7 @@ protected:
     */
    virtual std::vector<double> PDF(const AtHit &hit) = 0;
    void FillCDF();
+   double Uniform();
 
    std::vector<int> sampleIndicesFromCDF(int N, std::vector<int> vetoed = {});
    int getIndexFromCDF(double r, double rmCFD, std::vector<int> vetoed);
@@ -2,9 +2,6 @@
 
 #include "AtHit.h"
 
-#include <TRandom.h> // for TRandom
-#include <TRandom3.h>
-
 #include <utility> // for move
 
 using namespace RandomSample;
@@ -22,7 +19,7 @@ std::vector<AtHit> AtSampleFromReference::SampleHits(int N)
  */
 void AtSampleFromReference::SampleReferenceHit()
 {
-   int refIndex = gRandom->Uniform() * fHits->size();
+   int refIndex = Uniform() * fHits->size();
    SetReferenceHit(fHits->at(refIndex));
 }
 
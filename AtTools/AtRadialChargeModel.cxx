@@ -8,6 +8,7 @@
 #include <Math/Vector2D.h>
 #include <Math/Vector3D.h>
 
+#include <algorithm>
 #include <cmath>
 
 constexpr auto c = 29979.2;  //< c in cm/us
@@ -31,34 +32,57 @@ XYZPoint AtRadialChargeModel::ApplySpaceCharge(const XYZPoint &input)
    return SolveEqn(input / 10, false) * 10;
 }
 
-// Assumes units are cm
-XYZPoint AtRadialChargeModel::SolveEqn(XYZPoint ele, bool correct)
+void AtRadialChargeModel::CheckStepSize()
 {
    // Verify step size is logical
    auto minStepSize = 2 * fMobilityElec * me / c2;
    if (fStepSize < minStepSize) {
       LOG(error) << "Using unphysical step size: " << fStepSize << " reseting to minimum step size:" << minStepSize;
       fStepSize = minStepSize;
+      ClearLookupTables();
+   }
+}
+
+// Assumes units are cm
+XYZPoint AtRadialChargeModel::SolveEqn(XYZPoint ele, bool correct)
+{
+   CheckStepSize();
+
+   if (fUseLookupTable) {
+      auto &table = correct ? fCorrectTable : fApplyTable;
+      if (table.empty())
+         table = BuildLookupTable(correct);
+
+      auto pos = InterpolateLookupTable(table, ele.rho(), ele.Z());
+      if (!std::isnan(pos))
+         return XYZPoint(ROOT::Math::RhoZPhiPoint(pos, ele.Z(), ele.phi()));
    }
 
    // Drift to pad plane in z/vd
-   double timeToDrift = ele.Z() / fDriftVel; // us
-   int nBins = std::floor(timeToDrift / fStepSize);
-   LOG(debug) << "Drifting to " << ele.Z() << " in " << nBins << " steps of size " << fStepSize;
+   LOG(debug) << "Drifting to " << ele.Z() << " in " << std::floor(ele.Z() / fDriftVel / fStepSize)
+              << " steps of size " << fStepSize;
+   double pos = DriftRho(ele.rho(), ele.Z(), ele.Z() / fDriftVel, correct);
+   return XYZPoint(ROOT::Math::RhoZPhiPoint(pos, ele.Z(), ele.phi()));
+}
+
+/// Radial position of an electron starting at (rho, z) after drifting towards the pad plane for time [cm, us]
+double AtRadialChargeModel::DriftRho(double rho, double z, double time, bool correct)
+{
+   int nBins = std::floor(time / fStepSize);
 
-   double pos = ele.rho();
+   double pos = rho;
 
    // Calculate transporting from point to the pad plane
    for (int i = 0; i < nBins; ++i) {
 
       // Z = 0 is pad plane
-      auto z = ele.Z() - i * fStepSize * fDriftVel;
-      if (z < 0) {
+      auto zStep = z - i * fStepSize * fDriftVel;
+      if (zStep < 0) {
          LOG(error) << "Space charge correction tried to bypass the pad plane!";
          break;
       }
 
-      auto Efield = GetEField(pos, z);
+      auto Efield = GetEField(pos, zStep);
       if (!correct)
          Efield *= -1;
 
@@ -74,9 +98,9 @@ XYZPoint AtRadialChargeModel::SolveEqn(XYZPoint ele, bool correct)
    }
 
    // Perform the final step using the remaining time
-   auto dT = timeToDrift - nBins * fStepSize;
-   auto z = dT * fDriftVel;
-   auto Efield = GetEField(pos, z);
+   auto dT = time - nBins * fStepSize;
+   auto zStep = z - nBins * fStepSize * fDriftVel;
+   auto Efield = GetEField(pos, zStep);
    if (!correct)
       Efield *= -1;
    double v = Efield * fMobilityElec;
@@ -85,7 +109,92 @@ XYZPoint AtRadialChargeModel::SolveEqn(XYZPoint ele, bool correct)
       pos = 0;
    }
 
-   return XYZPoint(ROOT::Math::RhoZPhiPoint(pos, ele.Z(), ele.phi()));
+   return pos;
+}
+
+void AtRadialChargeModel::SetLookupTable(double rhoMax, double zMax, int numRho, int numZ, double tolerance)
+{
+   fUseLookupTable = rhoMax > 0 && zMax > 0 && numRho > 1 && numZ > 1;
+   fTableRhoMax = rhoMax / 10;
+   fTableZMax = zMax / 10;
+   fTableNumRho = numRho;
+   fTableNumZ = numZ;
+   fTableTolerance = tolerance / 10;
+   ClearLookupTables();
+}
+
+void AtRadialChargeModel::ClearLookupTables()
+{
+   fCorrectTable.clear();
+   fApplyTable.clear();
+}
+
+/**
+ * Fill the table one row of z at a time. An electron starting at (rho, z_k) drifts to z_(k-1) and from there
+ * follows the path already tabulated in row k-1, so each row only integrates the drift over one step in z. If
+ * an electron leaves the table the entry is NaN, and points depending on it are integrated directly.
+ */
+std::vector<Double_t> AtRadialChargeModel::BuildLookupTable(bool correct)
+{
+   LOG(info) << "Building space charge lookup table for " << (correct ? "CorrectSpaceCharge" : "ApplySpaceCharge");
+   auto dRho = fTableRhoMax / (fTableNumRho - 1);
+   auto dZ = fTableZMax / (fTableNumZ - 1);
+
+   std::vector<Double_t> table(fTableNumRho * fTableNumZ);
+   for (int iRho = 0; iRho < fTableNumRho; ++iRho)
+      table[iRho] = iRho * dRho;
+
+   for (int iZ = 1; iZ < fTableNumZ; ++iZ) {
+      const auto *prevRow = &table[(iZ - 1) * fTableNumRho];
+      for (int iRho = 0; iRho < fTableNumRho; ++iRho) {
+         auto pos = DriftRho(iRho * dRho, iZ * dZ, dZ / fDriftVel, correct) / dRho;
+         auto &entry = table[iZ * fTableNumRho + iRho];
+         if (pos > fTableNumRho - 1) {
+            entry = std::nan("");
+            continue;
+         }
+         auto i = std::min<int>(pos, fTableNumRho - 2);
+         entry = (1 - (pos - i)) * prevRow[i] + (pos - i) * prevRow[i + 1];
+      }
+   }
+
+   // Compare with direct integration at the center of a sample of cells
+   double maxDiff = 0;
+   const int numCheck = 5;
+   for (int i = 0; i < numCheck; ++i) {
+      for (int j = 0; j < numCheck; ++j) {
+         auto rho = (std::floor((i + 0.5) * (fTableNumRho - 1) / numCheck) + 0.5) * dRho;
+         auto z = (std::floor((j + 0.5) * (fTableNumZ - 1) / numCheck) + 0.5) * dZ;
+         auto pos = InterpolateLookupTable(table, rho, z);
+         if (!std::isnan(pos))
+            maxDiff = std::max(maxDiff, std::abs(pos - DriftRho(rho, z, z / fDriftVel, correct)));
+      }
+   }
+   if (maxDiff > fTableTolerance)
+      LOG(warn) << "Space charge lookup table differs from direct integration by up to " << maxDiff * 10
+                << " mm. Consider using more points.";
+   else
+      LOG(info) << "Space charge lookup table differs from direct integration by up to " << maxDiff * 10 << " mm";
+
+   return table;
+}
+
+/// Bilinear interpolation of the table at (rho, z) [cm], or NaN if the point is not covered by the table
+double AtRadialChargeModel::InterpolateLookupTable(const std::vector<Double_t> &table, double rho, double z) const
+{
+   if (table.empty() || rho < 0 || z < 0 || rho > fTableRhoMax || z > fTableZMax)
+      return std::nan("");
+
+   auto xRho = rho / fTableRhoMax * (fTableNumRho - 1);
+   auto xZ = z / fTableZMax * (fTableNumZ - 1);
+   auto iRho = std::min<int>(xRho, fTableNumRho - 2);
+   auto iZ = std::min<int>(xZ, fTableNumZ - 2);
+   auto tRho = xRho - iRho;
+   auto tZ = xZ - iZ;
+
+   const auto *row = &table[iZ * fTableNumRho + iRho];
+   return (1 - tZ) * ((1 - tRho) * row[0] + tRho * row[1]) +
+          tZ * ((1 - tRho) * row[fTableNumRho] + tRho * row[fTableNumRho + 1]);
 }
 
 void AtRadialChargeModel::LoadParameters(AtDigiPar *par)
@@ -101,11 +210,13 @@ void AtRadialChargeModel::SetEField(double field)
 {
    fEFieldZ = field;
    fMobilityElec = fDriftVel / fEFieldZ;
+   ClearLookupTables();
 }
 void AtRadialChargeModel::SetDriftVelocity(double v)
 {
    fDriftVel = v;
    fMobilityElec = fDriftVel / fEFieldZ;
+   ClearLookupTables();
 }
 
 /*
@@ -5,6 +5,9 @@
 
 #include <Math/Point2Dfwd.h>
 #include <Math/Vector2Dfwd.h>
+
+#include <vector>
+
 /**
  * @brief Space charge model from arbitrary radial E-field,
  *
@@ -29,18 +32,45 @@ private:
    Double_t fMobilityElec{1.17143e-3}; //< Mobility of electron (calculated from drift velocity) [cm2/V/us]
    Double_t fStepSize{1e-4};           //< Step size for solving differential equation [us]
 
+   Bool_t fUseLookupTable{false};
+   Double_t fTableRhoMax{0};           //< Largest rho in the lookup tables [cm]
+   Double_t fTableZMax{0};             //< Largest z in the lookup tables [cm]
+   Int_t fTableNumRho{0};              //< Number of points in rho of the lookup tables
+   Int_t fTableNumZ{0};                //< Number of points in z of the lookup tables
+   Double_t fTableTolerance{0.01};     //< Allowed difference between the tables and direct integration [cm]
+   std::vector<Double_t> fCorrectTable; //< Final rho [iZ * fTableNumRho + iRho] for CorrectSpaceCharge [cm]
+   std::vector<Double_t> fApplyTable;   //< Final rho [iZ * fTableNumRho + iRho] for ApplySpaceCharge [cm]
+
 public:
    AtRadialChargeModel(EFieldPtr efield);
 
    virtual XYZPoint CorrectSpaceCharge(const XYZPoint &directInputPosition) override;
    virtual XYZPoint ApplySpaceCharge(const XYZPoint &reverseInputPosition) override;
 
-   void SetStepSize(double setSize) { fStepSize = setSize; }
+   void SetStepSize(double setSize)
+   {
+      fStepSize = setSize;
+      ClearLookupTables();
+   }
    void SetEField(double field);
    void SetDriftVelocity(double v);
    void LoadParameters(AtDigiPar *par) override;
 
+   /**
+    * @brief Interpolate the displacement from a table instead of integrating the drift of every point.
+    *
+    * The tables cover a grid of numRho x numZ points with rho in [0, rhoMax] and z in [0, zMax] (in mm), and are
+    * built the first time they are needed. When built they are checked against direct integration, with a
+    * warning if they differ by more than tolerance (in mm). Points outside of the tables are integrated directly.
+    */
+   void SetLookupTable(double rhoMax, double zMax, int numRho = 200, int numZ = 200, double tolerance = 0.1);
+
 private:
    XYZPoint SolveEqn(XYZPoint ele, bool correction);
+   double DriftRho(double rho, double z, double time, bool correct);
+   void CheckStepSize();
+   void ClearLookupTables();
+   std::vector<Double_t> BuildLookupTable(bool correct);
+   double InterpolateLookupTable(const std::vector<Double_t> &table, double rho, double z) const;
 };
 #endif /* ATRADIALCHARGEMODEL_H */
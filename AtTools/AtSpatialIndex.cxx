@@ -0,0 +1,172 @@
+#include "AtSpatialIndex.h"
+
+#include "AtHit.h"
+
+#include <algorithm> // for nth_element, sort, push_heap, pop_heap
+#include <numeric>   // for iota
+#include <utility>   // for move, pair
+
+using namespace AtTools;
+
+namespace {
+double Distance2(const std::array<double, 3> &a, const std::array<double, 3> &b)
+{
+   double dx = a[0] - b[0];
+   double dy = a[1] - b[1];
+   double dz = a[2] - b[2];
+   return dx * dx + dy * dy + dz * dz;
+}
+std::array<double, 3> ToArray(const ROOT::Math::XYZPoint &point)
+{
+   return {point.X(), point.Y(), point.Z()};
+}
+} // namespace
+
+AtSpatialIndex::AtSpatialIndex(const std::vector<AtHit> &hits)
+{
+   std::vector<std::array<double, 3>> points;
+   points.reserve(hits.size());
+   for (const auto &hit : hits)
+      points.push_back(ToArray(hit.GetPosition()));
+   Build(std::move(points));
+}
+
+AtSpatialIndex::AtSpatialIndex(const std::vector<XYZPoint> &points)
+{
+   std::vector<std::array<double, 3>> arr;
+   arr.reserve(points.size());
+   for (const auto &point : points)
+      arr.push_back(ToArray(point));
+   Build(std::move(arr));
+}
+
+void AtSpatialIndex::Build(std::vector<std::array<double, 3>> points)
+{
+   fPoints = std::move(points);
+   fIndex.resize(fPoints.size());
+   std::iota(fIndex.begin(), fIndex.end(), 0);
+   fAxis.assign(fPoints.size(), 0);
+   BuildNode(0, fPoints.size());
+}
+
+/**
+ * Place the median point of [begin, end) along the axis with the largest spread at the middle of the range,
+ * with the points below it before and the points above it after. Then recurse into both halves.
+ */
+void AtSpatialIndex::BuildNode(std::size_t begin, std::size_t end)
+{
+   if (end - begin < 2)
+      return;
+
+   std::array<double, 3> min = fPoints[begin];
+   std::array<double, 3> max = fPoints[begin];
+   for (auto i = begin + 1; i < end; ++i) {
+      for (int axis = 0; axis < 3; ++axis) {
+         min[axis] = std::min(min[axis], fPoints[i][axis]);
+         max[axis] = std::max(max[axis], fPoints[i][axis]);
+      }
+   }
+   unsigned char axis = 0;
+   for (unsigned char i = 1; i < 3; ++i)
+      if (max[i] - min[i] > max[axis] - min[axis])
+         axis = i;
+
+   // Sort the tree order, then apply it to the points
+   std::vector<std::size_t> order(end - begin);
+   std::iota(order.begin(), order.end(), begin);
+   auto mid = begin + (end - begin) / 2;
+   std::nth_element(order.begin(), order.begin() + (mid - begin), order.end(),
+                    [this, axis](std::size_t a, std::size_t b) { return fPoints[a][axis] < fPoints[b][axis]; });
+
+   std::vector<std::array<double, 3>> points(order.size());
+   std::vector<std::size_t> index(order.size());
+   for (std::size_t i = 0; i < order.size(); ++i) {
+      points[i] = fPoints[order[i]];
+      index[i] = fIndex[order[i]];
+   }
+   std::copy(points.begin(), points.end(), fPoints.begin() + begin);
+   std::copy(index.begin(), index.end(), fIndex.begin() + begin);
+
+   fAxis[mid] = axis;
+   BuildNode(begin, mid);
+   BuildNode(mid + 1, end);
+}
+
+std::vector<std::size_t>
+AtSpatialIndex::GetKNearest(const XYZPoint &point, std::size_t k, std::vector<double> *dist2) const
+{
+   std::vector<Neighbor> heap;
+   if (k > 0) {
+      heap.reserve(k);
+      SearchKNearest(ToArray(point), k, 0, fPoints.size(), heap);
+   }
+   std::sort(heap.begin(), heap.end());
+
+   std::vector<std::size_t> ret;
+   ret.reserve(heap.size());
+   if (dist2 != nullptr)
+      dist2->clear();
+   for (const auto &[d2, idx] : heap) {
+      ret.push_back(idx);
+      if (dist2 != nullptr)
+         dist2->push_back(d2);
+   }
+   return ret;
+}
+
+void AtSpatialIndex::SearchKNearest(const std::array<double, 3> &point, std::size_t k, std::size_t begin,
+                                    std::size_t end, std::vector<Neighbor> &heap) const
+{
+   if (begin >= end)
+      return;
+
+   auto mid = begin + (end - begin) / 2;
+   Neighbor candidate{Distance2(point, fPoints[mid]), fIndex[mid]};
+   if (heap.size() < k) {
+      heap.push_back(candidate);
+      std::push_heap(heap.begin(), heap.end());
+   } else if (candidate < heap.front()) {
+      std::pop_heap(heap.begin(), heap.end());
+      heap.back() = candidate;
+      std::push_heap(heap.begin(), heap.end());
+   }
+
+   // Search the side of the split containing the point first, the other only if it could hold a closer point
+   auto axis = fAxis[mid];
+   double diff = point[axis] - fPoints[mid][axis];
+   if (diff < 0) {
+      SearchKNearest(point, k, begin, mid, heap);
+      if (heap.size() < k || diff * diff <= heap.front().first)
+         SearchKNearest(point, k, mid + 1, end, heap);
+   } else {
+      SearchKNearest(point, k, mid + 1, end, heap);
+      if (heap.size() < k || diff * diff <= heap.front().first)
+         SearchKNearest(point, k, begin, mid, heap);
+   }
+}
+
+std::vector<std::size_t> AtSpatialIndex::GetInRadius(const XYZPoint &point, double r) const
+{
+   std::vector<std::size_t> ret;
+   SearchRadius(ToArray(point), r * r, 0, fPoints.size(), ret);
+   std::sort(ret.begin(), ret.end());
+   return ret;
+}
+
+void AtSpatialIndex::SearchRadius(const std::array<double, 3> &point, double r2, std::size_t begin, std::size_t end,
+                                  std::vector<std::size_t> &result) const
+{
+   if (begin >= end)
+      return;
+
+   auto mid = begin + (end - begin) / 2;
+   if (Distance2(point, fPoints[mid]) <= r2)
+      result.push_back(fIndex[mid]);
+
+   auto axis = fAxis[mid];
+   double diff = point[axis] - fPoints[mid][axis];
+   if (diff <= 0 || diff * diff <= r2)
+      SearchRadius(point, r2, begin, mid, result);
+   if (diff >= 0 || diff * diff <= r2)
+      SearchRadius(point, r2, mid + 1, end, result);
+}
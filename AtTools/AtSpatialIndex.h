@@ -0,0 +1,65 @@
+#ifndef ATSPATIALINDEX_H
+#define ATSPATIALINDEX_H
+
+#include <Math/Point3D.h>
+#include <Math/Point3Dfwd.h> // for XYZPoint
+
+#include <array>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+class AtHit;
+
+namespace AtTools {
+
+/**
+ * @brief k-d tree over a cloud of 3D points.
+ *
+ * Built once from the positions of a set of hits (or any points), after which nearest-neighbor and
+ * radius queries take O(log N) instead of looping over every point. Queries return the index of the points
+ * in the vector the index was built from. The index does not keep a reference to the hits, so it must be
+ * rebuilt if they change.
+ */
+class AtSpatialIndex {
+public:
+   using XYZPoint = ROOT::Math::XYZPoint;
+
+private:
+   std::vector<std::array<double, 3>> fPoints; //< Points in tree order
+   std::vector<std::size_t> fIndex;            //< Index of each point (in tree order) in the input
+   std::vector<unsigned char> fAxis;           //< Axis each node splits on
+
+public:
+   AtSpatialIndex() = default;
+   explicit AtSpatialIndex(const std::vector<AtHit> &hits);
+   explicit AtSpatialIndex(const std::vector<XYZPoint> &points);
+
+   std::size_t size() const { return fPoints.size(); }
+   bool empty() const { return fPoints.empty(); }
+
+   /**
+    * @brief Indices of the k points closest to point, closest first.
+    *
+    * If point is in the index, it is returned as its own nearest neighbor. Ties are broken by index.
+    * @param[out] dist2 If not null, filled with the squared distance to each returned point.
+    */
+   std::vector<std::size_t>
+   GetKNearest(const XYZPoint &point, std::size_t k, std::vector<double> *dist2 = nullptr) const;
+   /// Indices of all points within r (inclusive) of point, in ascending order
+   std::vector<std::size_t> GetInRadius(const XYZPoint &point, double r) const;
+
+private:
+   void Build(std::vector<std::array<double, 3>> points);
+   void BuildNode(std::size_t begin, std::size_t end);
+
+   using Neighbor = std::pair<double, std::size_t>; // Squared distance and input index
+   void SearchKNearest(const std::array<double, 3> &point, std::size_t k, std::size_t begin, std::size_t end,
+                       std::vector<Neighbor> &heap) const;
+   void SearchRadius(const std::array<double, 3> &point, double r2, std::size_t begin, std::size_t end,
+                     std::vector<std::size_t> &result) const;
+};
+
+} // namespace AtTools
+
+#endif //#ifndef ATSPATIALINDEX_H
@@ -13,6 +13,7 @@
 #pragma link C++ class AtTools::AtParsers + ;
 #pragma link C++ class AtEulerTransformation + ;
 #pragma link C++ class AtTools::AtTrackTransformer - !;
+#pragma link C++ class AtTools::AtSpatialIndex - !;
 
 #pragma link C++ class AtSpaceChargeModel + ;
 #pragma link C++ class AtLineChargeModel + ;
@@ -1,5 +1,9 @@
 #include "AtTrackTransformer.h"
 
+#include "AtHit.h"
+#include "AtHitCluster.h"
+#include "AtSpatialIndex.h"
+
 #include <Math/Point3D.h>     // for PositionVector3D, Cart...
 #include <Math/Vector2D.h>    // for PositionVector3D, Cart...
 #include <Math/Vector2Dfwd.h> // for XYVector
@@ -8,160 +12,185 @@
 #include <TMath.h>            // for Power, Sqrt, ATan2, Pi
 #include <TMatrixDSymfwd.h>   // for TMatrixDSym
 #include <TMatrixTSym.h>      // for TMatrixTSym
-#include <TVector3.h>         // for TVector3
 
-#include <algorithm>          // for max, for_each, copy_if
-#include <cmath>              // for fabs, acos
-#include <cstddef>            // for size_t
-#include <exception>          // for exception
-#include <ext/alloc_traits.h> // for __alloc_traits<>::valu...
-#include <iostream>           // for operator<<, basic_ostream
-#include <iterator>           // for back_insert_iterator
-#include <memory>             // for shared_ptr, __shared_p...
+#include <algorithm>     // for remove_if
+#include <cmath>         // for floor
+#include <cstddef>       // for size_t
+#include <cstdint>       // for int64_t
+#include <memory>        // for shared_ptr, make_shared
+#include <unordered_map> // for unordered_map
+
+using XYZPoint = ROOT::Math::XYZPoint;
+
+namespace {
+// Diffusion coefficients (TODO: Get them from the parameter file)
+constexpr Double_t driftVel = 1.0;       // cm/us
+constexpr Double_t samplingRate = 0.320; // us
+constexpr Double_t d_t = 0.0009;         // cm^2/us
+constexpr Double_t d_l = 0.0009;         // cm^2/us
+
+/**
+ * Indices (ascending) of the hits strictly closer than radius to point. The index is searched with a slightly
+ * larger radius so rounding cannot drop a hit that passes the exact test.
+ */
+std::vector<std::size_t> GetHitsInRadius(const std::vector<AtHit> &hitArray, const AtTools::AtSpatialIndex &index,
+                                         const XYZPoint &point, Double_t radius)
+{
+   auto ret = index.GetInRadius(point, radius * (1 + 1e-9));
+   ret.erase(std::remove_if(ret.begin(), ret.end(),
+                            [&](std::size_t i) {
+                               return !(TMath::Sqrt((hitArray[i].GetPosition() - point).Mag2()) < radius);
+                            }),
+             ret.end());
+   return ret;
+}
+
+/// Cluster of the hits at indices hits, with the charge weighted position and diffusion based covariance
+std::shared_ptr<AtHitCluster>
+MakeHitCluster(const std::vector<AtHit> &hitArray, const std::vector<std::size_t> &hits, int clusterID)
+{
+   Double_t D_T = TMath::Sqrt((2.0 * d_t) / driftVel);
+   Double_t D_L = TMath::Sqrt((2.0 * d_l) / driftVel);
+
+   double x = 0, y = 0, z = 0;
+   double sigma_x = 0, sigma_y = 0, sigma_z = 0;
+
+   int timeStamp = 0;
+   auto hitCluster = std::make_shared<AtHitCluster>();
+   hitCluster->SetClusterID(clusterID);
+   Double_t hitQ = 0.0;
+   for (auto i : hits) {
+      const auto &hitInQ = hitArray[i];
+      auto pos = hitInQ.GetPosition();
+      x += pos.X() * hitInQ.GetCharge();
+      y += pos.Y() * hitInQ.GetCharge();
+      z += pos.Z();
+      hitQ += hitInQ.GetCharge();
+      timeStamp += hitInQ.GetTimeStamp();
+
+      // Calculation of variance (DOI: 10.1051/,00010 (2017)715001EPJ Web of
+      // Conferences50epjconf/2010010)
+      sigma_x += hitInQ.GetCharge() *
+                 TMath::Sqrt(TMath::Power(0.2, 2) + pos.Z() * TMath::Power(D_T, 2)); // 0.2 mm of position resolution
+      sigma_y += sigma_x;
+      sigma_z +=
+         TMath::Sqrt((1.0 / 6.0) * TMath::Power(driftVel * samplingRate, 2) + pos.Z() * TMath::Power(D_L, 2));
+   }
+   x /= hitQ;
+   y /= hitQ;
+   z /= hits.size();
+   timeStamp /= hits.size();
+
+   sigma_x /= hitQ;
+   sigma_y /= hitQ;
+   sigma_z /= hits.size();
+
+   hitCluster->SetCharge(hitQ);
+   hitCluster->SetPosition({x, y, z});
+   hitCluster->SetTimeStamp(timeStamp);
+   TMatrixDSym cov(3); // TODO: Setting covariant matrix based on pad size and drift time resolution.
+                       // Using estimations for the moment.
+   cov(0, 1) = 0;
+   cov(1, 2) = 0;
+   cov(2, 0) = 0;
+   cov(0, 0) = TMath::Power(sigma_x, 2); // 0.04;
+   cov(1, 1) = TMath::Power(sigma_y, 2); // 0.04;
+   cov(2, 2) = TMath::Power(sigma_z, 2); // 0.01;
+   hitCluster->SetCovMatrix(cov);
+   return hitCluster;
+}
+
+/**
+ * Cluster positions binned in cubes of side distance, so checking if a new cluster is closer than distance to an
+ * existing one only looks at the 27 neighboring cubes.
+ */
+class ClusterGrid {
+   Double_t fDistance;
+   std::unordered_map<std::int64_t, std::vector<XYZPoint>> fCells;
+
+   std::int64_t Cell(double x) const { return std::floor(x / fDistance); }
+   static std::int64_t Key(std::int64_t i, std::int64_t j, std::int64_t k)
+   {
+      return (i & 0x1FFFFF) | ((j & 0x1FFFFF) << 21) | ((k & 0x1FFFFF) << 42);
+   }
+
+public:
+   explicit ClusterGrid(Double_t distance) : fDistance(distance) {}
+
+   void Add(const XYZPoint &pos)
+   {
+      if (fDistance > 0)
+         fCells[Key(Cell(pos.X()), Cell(pos.Y()), Cell(pos.Z()))].push_back(pos);
+   }
+
+   bool HasClusterWithin(const XYZPoint &pos) const
+   {
+      if (!(fDistance > 0))
+         return false;
+
+      auto i = Cell(pos.X());
+      auto j = Cell(pos.Y());
+      auto k = Cell(pos.Z());
+      for (auto di = i - 1; di <= i + 1; ++di)
+         for (auto dj = j - 1; dj <= j + 1; ++dj)
+            for (auto dk = k - 1; dk <= k + 1; ++dk) {
+               auto cell = fCells.find(Key(di, dj, dk));
+               if (cell == fCells.end())
+                  continue;
+               for (const auto &clusPos : cell->second)
+                  if (TMath::Sqrt((clusPos - pos).Mag2()) < fDistance)
+                     return true;
+            }
+      return false;
+   }
+};
+} // namespace
 
 AtTools::AtTrackTransformer::AtTrackTransformer() = default;
 AtTools::AtTrackTransformer::~AtTrackTransformer() = default;
 
+/**
+ * Hits are gathered with a spatial index over the hits of the track and new clusters are checked against the
+ * existing ones with a grid, so clustering is close to linear in the number of hits.
+ */
 void AtTools::AtTrackTransformer::ClusterizeSmooth3D(AtTrack &track, Float_t distance, Float_t radius)
 {
-   std::vector<AtHit> hitArray = track.GetHitArray();
-   std::vector<AtHit> hitTBArray;
+   const std::vector<AtHit> &hitArray = track.GetHitArrayConst();
    int clusterID = 0;
 
-   // std::cout<<" ================================================================= "<<"\n";
-   // std::cout<<" Clusterizing track : "<<track.GetTrackID()<<"\n";
-
-   /*for(auto iHits=0;iHits<hitArray->size();++iHits)
-     {
-       TVector3 pos    = hitArray->at(iHits).GetPosition();
-       double Q = hitArray->at(iHits).GetCharge();
-       int TB          = hitArray->at(iHits).GetTimeStamp();
-       //std::cout<<" Pos : "<<pos.X()<<" - "<<pos.Y()<<" - "<<pos.Z()<<" - TB : "<<TB<<" - Charge : "<<Q<<"\n";
-       }*/
-
-   // Diffusion coefficients (TODO: Get them from the parameter file)
-   Double_t driftVel = 1.0;       // cm/us
-   Double_t samplingRate = 0.320; // us
-   Double_t d_t = 0.0009;         // cm^2/us
-   Double_t d_l = 0.0009;         // cm^2/us
-   Double_t D_T = TMath::Sqrt((2.0 * d_t) / driftVel);
-   Double_t D_L = TMath::Sqrt((2.0 * d_l) / driftVel);
-
    if (hitArray.size() > 0) {
 
+      AtTools::AtSpatialIndex index(hitArray);
+
+      ClusterGrid clusterGrid(distance);
+      for (const auto &cluster : track.GetHitClusterArrayConst())
+         clusterGrid.Add(cluster.GetPosition());
+
       auto refPos = hitArray.at(0).GetPosition(); // First hit
       // TODO: Create a clustered hit from the very first hit (test)
 
-      for (auto iHit = 0; iHit < hitArray.size(); ++iHit) {
-
-         auto hit = hitArray.at(iHit);
+      for (const auto &hit : hitArray) {
 
          // Check distance with respect to reference Hit
          Double_t distRef = TMath::Sqrt((hit.GetPosition() - refPos).Mag2());
 
-         if (distRef < distance) {
-
-            continue;
-
-         } else {
-
-            // std::cout<<" Clustering "<<iHit<<" of "<<hitArray->size()<<"\n";
-            // std::cout<<" Distance to reference : "<<distRef<<"\n";
-            // std::cout<<" Reference position : "<<refPos.X()<<" - "<<refPos.Y()<<" - "<<refPos.Z()<<" -
-            // "<<refPos.Mag()<<"\n";
+         if (distRef >= distance) {
 
-            Double_t clusterQ = 0.0;
-            hitTBArray.clear();
-            std::copy_if(
-               hitArray.begin(), hitArray.end(), std::back_inserter(hitTBArray),
-               [&refPos, radius](AtHit &hitIn) { return TMath::Sqrt((hitIn.GetPosition() - refPos).Mag2()) < radius; });
-
-            // std::cout<<" Clustered "<<hitTBArray.size()<<" Hits "<<"\n";
+            auto hitTBArray = GetHitsInRadius(hitArray, index, refPos, radius);
 
             if (hitTBArray.size() > 0) {
-               double x = 0, y = 0, z = 0;
-               double sigma_x = 0, sigma_y = 0, sigma_z = 0;
-
-               int timeStamp;
-               std::shared_ptr<AtHitCluster> hitCluster = std::make_shared<AtHitCluster>();
-               hitCluster->SetClusterID(clusterID);
-               Double_t hitQ = 0.0;
-               std::for_each(hitTBArray.begin(), hitTBArray.end(),
-                             [&x, &y, &z, &hitQ, &timeStamp, &sigma_x, &sigma_y, &sigma_z, &D_T, &D_L, &driftVel,
-                              &samplingRate](AtHit &hitInQ) {
-                                XYZPoint pos = hitInQ.GetPosition();
-                                x += pos.X() * hitInQ.GetCharge();
-                                y += pos.Y() * hitInQ.GetCharge();
-                                z += pos.Z();
-                                hitQ += hitInQ.GetCharge();
-                                timeStamp += hitInQ.GetTimeStamp();
-
-                                // Calculation of variance (DOI: 10.1051/,00010 (2017)715001EPJ Web of
-                                // Conferences50epjconf/2010010)
-                                sigma_x += hitInQ.GetCharge() *
-                                           TMath::Sqrt(TMath::Power(0.2, 2) +
-                                                       pos.Z() * TMath::Power(D_T, 2)); // 0.2 mm of position resolution
-                                sigma_y += sigma_x;
-                                sigma_z += TMath::Sqrt((1.0 / 6.0) * TMath::Power(driftVel * samplingRate, 2) +
-                                                       pos.Z() * TMath::Power(D_L, 2));
-                             });
-               x /= hitQ;
-               y /= hitQ;
-               z /= hitTBArray.size();
-               timeStamp /= hitTBArray.size();
-
-               sigma_x /= hitQ;
-               sigma_y /= hitQ;
-               sigma_z /= hitTBArray.size();
-
-               XYZPoint clustPos(x, y, z);
-               Bool_t checkDistance = kTRUE;
+               auto hitCluster = MakeHitCluster(hitArray, hitTBArray, clusterID);
 
                // Check distance with respect to existing clusters
-               for (auto iClusterHit : *track.GetHitClusterArray()) {
-                  if (TMath::Sqrt((iClusterHit.GetPosition() - clustPos).Mag2()) < distance) {
-                     // std::cout<<" Cluster with less than  : "<<distance<<" found "<<"\n";
-                     checkDistance = kFALSE;
-                     continue;
-                  }
-               }
-
-               if (checkDistance) {
-                  hitCluster->SetCharge(hitQ);
-                  hitCluster->SetPosition({x, y, z});
-                  hitCluster->SetTimeStamp(timeStamp);
-                  TMatrixDSym cov(3); // TODO: Setting covariant matrix based on pad size and drift time resolution.
-                                      // Using estimations for the moment.
-                  cov(0, 1) = 0;
-                  cov(1, 2) = 0;
-                  cov(2, 0) = 0;
-                  cov(0, 0) = TMath::Power(sigma_x, 2); // 0.04;
-                  cov(1, 1) = TMath::Power(sigma_y, 2); // 0.04;
-                  cov(2, 2) = TMath::Power(sigma_z, 2); // 0.01;
-                  hitCluster->SetCovMatrix(cov);
+               if (!clusterGrid.HasClusterWithin(hitCluster->GetPosition())) {
                   ++clusterID;
+                  clusterGrid.Add(hitCluster->GetPosition());
                   track.AddClusterHit(hitCluster);
                }
             }
-         }
-
-         // Sanity check
-         /*std::cout<<" Hits for cluster "<<iHit<<" centered in "<<refPos.X()<<" - "<<refPos.Y()<<"-"<<refPos.Z()<<"\n";
-    for(auto iHits=0;iHits<hitTBArray.size();++iHits)
-         {
-           TVector3 pos    = hitTBArray.at(iHits).GetPosition();
-           double Q = hitTBArray.at(iHits).GetCharge();
-           int TB          = hitTBArray.at(iHits).GetTimeStamp();
-           std::cout<<" Pos : "<<pos.X()<<" - "<<pos.Y()<<" - "<<pos.Z()<<" - TB : "<<TB<<" - Charge : "<<Q<<"\n";
-      std::cout<<" Distance to cluster center "<<TMath::Abs((track.GetHitClusterArray()->back().GetPosition() -
-    pos).Mag())<<"\n";
-    }
-         std::cout<<"=================================================="<<"\n";*/
-
-         refPos = hitArray.at(iHit).GetPosition();
-
-         //} // if distance
 
+            refPos = hit.GetPosition();
+         }
       } // for
 
       // Smoothing track
@@ -169,8 +198,6 @@ void AtTools::AtTrackTransformer::ClusterizeSmooth3D(AtTrack &track, Float_t dis
       radius /= 2.0;
       std::vector<std::shared_ptr<AtHitCluster>> hitClusterBuffer;
 
-      // std::cout<<" Hit cluster array size "<<hitClusterArray->size()<<"\n";
-
       if (hitClusterArray->size() > 2) {
 
          for (auto iHitCluster = 0; iHitCluster < hitClusterArray->size() - 1;
@@ -186,67 +213,13 @@ void AtTools::AtTrackTransformer::ClusterizeSmooth3D(AtTrack &track, Float_t dis
                renormClus.push_back(clusForw);
 
             // Create a new cluster and renormalize the charge of the other with half the radius.
-            for (auto iClus : renormClus) {
-               hitTBArray.clear();
-               std::copy_if(hitArray.begin(), hitArray.end(), std::back_inserter(hitTBArray),
-                            [&iClus, radius](AtHit &hitIn) {
-                               return TMath::Sqrt((hitIn.GetPosition() - iClus).Mag2()) < radius;
-                            });
+            for (const auto &iClus : renormClus) {
+               auto hitTBArray = GetHitsInRadius(hitArray, index, iClus, radius);
 
                if (hitTBArray.size() > 0) {
-                  double x = 0, y = 0, z = 0;
-                  double sigma_x = 0, sigma_y = 0, sigma_z = 0;
-
-                  int timeStamp = 0;
-                  std::shared_ptr<AtHitCluster> hitCluster = std::make_shared<AtHitCluster>();
-                  hitCluster->SetClusterID(clusterID);
-                  Double_t hitQ = 0.0;
-                  std::for_each(hitTBArray.begin(), hitTBArray.end(),
-                                [&x, &y, &z, &hitQ, &timeStamp, &sigma_x, &sigma_y, &sigma_z, &D_T, &D_L, &driftVel,
-                                 &samplingRate](AtHit &hitInQ) {
-                                   auto pos = hitInQ.GetPosition();
-                                   x += pos.X() * hitInQ.GetCharge();
-                                   y += pos.Y() * hitInQ.GetCharge();
-                                   z += pos.Z();
-                                   hitQ += hitInQ.GetCharge();
-                                   timeStamp += hitInQ.GetTimeStamp();
-
-                                   // Calculation of variance (DOI: 10.1051/,00010 (2017)715001EPJ Web of
-                                   // Conferences50epjconf/2010010)
-                                   sigma_x +=
-                                      hitInQ.GetCharge() *
-                                      TMath::Sqrt(TMath::Power(0.2, 2) +
-                                                  pos.Z() * TMath::Power(D_T, 2)); // 0.2 mm of position resolution
-                                   sigma_y += sigma_x;
-                                   sigma_z += TMath::Sqrt((1.0 / 6.0) * TMath::Power(driftVel * samplingRate, 2) +
-                                                          pos.Z() * TMath::Power(D_L, 2));
-                                });
-                  x /= hitQ;
-                  y /= hitQ;
-                  z /= hitTBArray.size();
-                  timeStamp /= hitTBArray.size();
-
-                  sigma_x /= hitQ;
-                  sigma_y /= hitQ;
-                  sigma_z /= hitTBArray.size();
-
-                  TVector3 clustPos(x, y, z);
-                  hitCluster->SetCharge(hitQ);
-                  hitCluster->SetPosition({x, y, z});
-                  hitCluster->SetTimeStamp(timeStamp);
-                  TMatrixDSym cov(3); // TODO: Setting covariant matrix based on pad size and drift time resolution.
-                                      // Using estimations for the moment.
-                  cov(0, 1) = 0;
-                  cov(1, 2) = 0;
-                  cov(2, 0) = 0;
-                  cov(0, 0) = TMath::Power(sigma_x, 2); // 0.04;
-                  cov(1, 1) = TMath::Power(sigma_y, 2); // 0.04;
-                  cov(2, 2) = TMath::Power(sigma_z, 2); // 0.01;
-                  hitCluster->SetCovMatrix(cov);
+                  hitClusterBuffer.push_back(MakeHitCluster(hitArray, hitTBArray, clusterID));
                   ++clusterID;
-                  hitClusterBuffer.push_back(hitCluster);
-
-               } // hitTBArray size
+               }
 
             } // for iClus
 
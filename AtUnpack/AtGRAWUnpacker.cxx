@@ -17,6 +17,7 @@
 #include "GETDecoder2.h"
 
 #include <algorithm>
+#include <array>
 #include <iostream>
 #include <iterator> // for begin, end
 #include <thread>
@@ -30,6 +31,12 @@ AtGRAWUnpacker::AtGRAWUnpacker(mapPtr map, Int_t numGrawFiles)
       fPedestal.push_back(std::make_unique<AtPedestal>());
    }
 }
+
+AtGRAWUnpacker::~AtGRAWUnpacker()
+{
+   StopWorkers();
+}
+
 void AtGRAWUnpacker::Init()
 {
    // Verify input file is there and matches constructor
@@ -38,8 +45,10 @@ void AtGRAWUnpacker::Init()
    // Because we added the files after creation, need to set the index of the first data file
    // to unpack for each cobo/asad
    fIsData = true;
-   for (auto &decoder : fDecoder)
+   for (auto &decoder : fDecoder) {
+      decoder->SetUseMappedFiles(fUseMappedFiles);
       fIsData &= decoder->SetData(0);
+   }
 
    if (!fIsData)
       LOG(error) << "Problem setting the data pointer to the first file in the list!";
@@ -68,15 +77,24 @@ void AtGRAWUnpacker::FillRawEvent(AtRawEvent &event)
    }
 
    if (fIsSeparatedData) {
-      std::vector<std::thread> file;
+      if (fWorkers.empty())
+         StartWorkers(fTargetFrameID);
 
+      // The workers have already decoded this frame (or are decoding it), so just move the pads over
       for (Int_t iFile = 0; iFile < fNumFiles; iFile++) {
-         file.emplace_back([this](Int_t fileIdx) { this->ProcessBasicFile(fileIdx); }, iFile);
-         // file[iFile] = std::thread([this](Int_t fileIdx) { this->ProcessBasicFile(fileIdx); }, iFile);
-      }
+         auto &frame = WaitForFrame(iFile, fTargetFrameID);
+         if (!frame.fIsValid) {
+            LOG(error) << "Basic frame was null! Skipping event " << fEventID;
+            event.SetIsGood(kFALSE);
+         } else {
+            LOG(debug) << "Looking for " << fTargetFrameID << " found " << frame.fEventID;
+            fCurrentEventID[iFile] = frame.fEventID;
+         }
 
-      for (auto &fileThread : file)
-         fileThread.join();
+         for (auto &pad : frame.fPads)
+            event.AddPad(std::move(pad));
+         PopFrame(iFile);
+      }
 
       // NB: Do not delete. To be refactored using functors
       /* for (Int_t iFile = 0; iFile < fNumFiles; iFile++){
@@ -124,9 +142,13 @@ void AtGRAWUnpacker::FillRawEvent(AtRawEvent &event)
 bool AtGRAWUnpacker::IsLastEvent()
 {
    if (fIsSeparatedData) {
+      // The decoders belong to the workers, so ask them if the next frame exists
+      if (fWorkers.empty())
+         StartWorkers(fTargetFrameID);
+
       bool isLastEvent = false;
       for (int i = 0; i < fNumFiles; ++i)
-         isLastEvent |= fDecoder[i]->GetBasicFrame(fDataEventID) == nullptr;
+         isLastEvent |= !WaitForFrame(i, fTargetFrameID).fIsValid;
       return isLastEvent;
    } else {
       if (dynamic_cast<AtTpcMap *>(fMap.get()) != nullptr) {
@@ -209,11 +231,13 @@ void AtGRAWUnpacker::ProcessFile(Int_t coboIdx)
       Int_t iAsad = frame->GetAsadID();
 
       for (Int_t iAget = 0; iAget < 4; iAget++) {
+         std::array<AtPad *, AtPedestal::kNumChannels> pads{};
+         std::array<Double_t *, AtPedestal::kNumChannels> adcs{};
          for (Int_t iCh = 0; iCh < 68; iCh++) {
 
             AtPadReference PadRef = {iCobo, iAsad, iAget, iCh};
             Int_t PadRefNum = fMap->GetPadNum(PadRef);
-            auto PadCenterCoord = fMap->CalcPadCenter(PadRefNum);
+            auto PadCenterCoord = fMap->GetPadCenter(PadRefNum);
 
             if (PadRefNum != -1 && fMap->IsInhibited(PadRefNum) == AtMap::InhibitType::kNone) {
                AtPad *pad = nullptr;
@@ -230,94 +254,172 @@ void AtGRAWUnpacker::ProcessFile(Int_t coboIdx)
                   pad->SetValidPad(kTRUE);
 
                Int_t *rawadc = frame->GetSample(iAget, iCh);
-               for (Int_t iTb = 0; iTb < 512; iTb++)
-                  pad->SetRawADC(iTb, rawadc[iTb]);
-
-               Int_t fpnCh = GetFPNChannel(iCh);
-               Double_t adc[512] = {0};
-               fPedestal[coboIdx]->SubtractPedestal(512, frame->GetSample(iAget, fpnCh), rawadc, adc,
-                                                    fFPNSigmaThreshold);
-
-               for (Int_t iTb = 0; iTb < 512; iTb++)
-                  pad->SetADC(iTb, adc[iTb]);
+               std::copy_n(rawadc, 512, pad->GetRawADCBuffer().begin());
 
-               pad->SetPedestalSubtracted(kTRUE);
+               pads[iCh] = pad;
+               adcs[iCh] = pad->GetADCBuffer().data();
             }
          }
+
+         // Subtract the whole chip at once, writing directly into the pads
+         fPedestal[coboIdx]->SubtractPedestal(frame->GetSample(iAget, 0), adcs, fFPNSigmaThreshold);
+         for (auto pad : pads)
+            if (pad != nullptr)
+               pad->SetPedestalSubtracted(kTRUE);
       }
    }
 }
 
-void AtGRAWUnpacker::ProcessBasicFile(Int_t coboIdx)
+AtGRAWUnpacker::DecodedFrame AtGRAWUnpacker::DecodeBasicFile(Int_t coboIdx, Int_t frameID)
 {
+   DecodedFrame decoded;
+   decoded.fFrameID = frameID;
 
-   GETBasicFrame *basicFrame = fDecoder[coboIdx]->GetBasicFrame(fTargetFrameID);
-
-   if (basicFrame == nullptr) {
-      fRawEvent->SetIsGood(kFALSE);
-      LOG(error) << "Basic frame was null! Skipping event " << fEventID;
-      return;
-   }
-   LOG(debug) << "Looking for " << fTargetFrameID << " found " << basicFrame->GetEventID();
+   GETBasicFrame *basicFrame = fDecoder[coboIdx]->GetBasicFrame(frameID);
+   if (basicFrame == nullptr)
+      return decoded;
 
-   fCurrentEventID[coboIdx] = basicFrame->GetEventID();
+   decoded.fIsValid = true;
+   decoded.fEventID = basicFrame->GetEventID();
    Int_t iCobo = basicFrame->GetCoboID();
    Int_t iAsad = basicFrame->GetAsadID();
 
    for (Int_t iAget = 0; iAget < 4; iAget++) {
+      auto firstPad = decoded.fPads.size();
+      std::array<Double_t *, AtPedestal::kNumChannels> adcs{};
       for (Int_t iCh = 0; iCh < 68; iCh++) {
 
          AtPadReference PadRef = {iCobo, iAsad, iAget, iCh};
          auto PadRefNum = fMap->GetPadNum(PadRef);
-         auto PadCenterCoord = fMap->CalcPadCenter(PadRefNum);
 
          if (PadRefNum != -1 && fMap->IsInhibited(PadRefNum) == AtMap::InhibitType::kNone) {
-            AtPad *pad = nullptr;
-            {
-               // Ensure the threads aren't both trying to create pads at the same time
-               std::lock_guard<std::mutex> lk(fRawEventMutex);
-               pad = fRawEvent->AddPad(PadRefNum);
-            }
+            auto pad = std::make_unique<AtPad>(PadRefNum);
 
-            pad->SetPadCoord(PadCenterCoord);
+            pad->SetPadCoord(fMap->GetPadCenter(PadRefNum));
             pad->SetValidPad(kTRUE);
 
             Int_t *rawadc = basicFrame->GetSample(iAget, iCh);
+            std::copy_n(rawadc, 512, pad->GetRawADCBuffer().begin());
 
-            for (Int_t iTb = 0; iTb < 512; iTb++) {
-               pad->SetRawADC(iTb, rawadc[iTb]);
-               // std::cout<<iTb<<" "<<rawadc[iTb]<<"\n";
-            }
+            adcs[iCh] = pad->GetADCBuffer().data();
+            decoded.fPads.push_back(std::move(pad));
+         }
+      }
 
-            Int_t fpnCh = GetFPNChannel(iCh);
-            Double_t adc[512] = {0};
-            fPedestal[coboIdx]->SubtractPedestal(512, basicFrame->GetSample(iAget, fpnCh), rawadc, adc,
-                                                 fFPNSigmaThreshold);
+      // Subtract the whole chip at once, writing directly into the pads
+      fPedestal[coboIdx]->SubtractPedestal(basicFrame->GetSample(iAget, 0), adcs, fFPNSigmaThreshold);
+      for (auto iPad = firstPad; iPad < decoded.fPads.size(); ++iPad)
+         decoded.fPads[iPad]->SetPedestalSubtracted(kTRUE);
+   }
 
-            for (Int_t iTb = 0; iTb < 512; iTb++)
-               pad->SetADC(iTb, adc[iTb]);
+   return decoded;
+}
 
-            pad->SetPedestalSubtracted(kTRUE);
-         }
+/**
+ * Start one worker per file, decoding frames starting at frameID. From here on the
+ * decoders are only touched by the worker threads.
+ */
+void AtGRAWUnpacker::StartWorkers(Int_t frameID)
+{
+   for (Int_t iFile = 0; iFile < fNumFiles; iFile++) {
+      fWorkers.push_back(std::make_unique<FileWorker>());
+      fWorkers.back()->fNextFrameID = frameID;
+      fWorkers.back()->fExpectedFrameID = frameID;
+   }
+
+   for (Int_t iFile = 0; iFile < fNumFiles; iFile++)
+      fWorkers[iFile]->fThread = std::thread([this](Int_t fileIdx) { this->RunWorker(fileIdx); }, iFile);
+}
+
+void AtGRAWUnpacker::StopWorkers()
+{
+   for (auto &worker : fWorkers) {
+      {
+         std::lock_guard<std::mutex> lk(worker->fMutex);
+         worker->fIsStopped = true;
       }
+      worker->fCondition.notify_all();
    }
+
+   for (auto &worker : fWorkers)
+      if (worker->fThread.joinable())
+         worker->fThread.join();
+   fWorkers.clear();
 }
 
-Int_t AtGRAWUnpacker::GetFPNChannel(Int_t chIdx)
+void AtGRAWUnpacker::RunWorker(Int_t fileIdx)
 {
-   Int_t fpn = -1;
-
-   if (chIdx < 17)
-      fpn = 11;
-   else if (chIdx < 34)
-      fpn = 22;
-   else if (chIdx < 51)
-      fpn = 45;
-   else
-      fpn = 56;
-
-   return fpn;
+   auto &worker = *fWorkers[fileIdx];
+
+   while (true) {
+      Int_t frameID = 0;
+      Int_t generation = 0;
+      {
+         std::unique_lock<std::mutex> lk(worker.fMutex);
+         worker.fCondition.wait(lk, [&worker, this] {
+            return worker.fIsStopped || (!worker.fHitEndOfFile && worker.fFrames.size() < fPrefetchDepth);
+         });
+         if (worker.fIsStopped)
+            return;
+
+         frameID = worker.fNextFrameID++;
+         generation = worker.fGeneration;
+      }
+
+      auto frame = DecodeBasicFile(fileIdx, frameID);
+
+      {
+         std::lock_guard<std::mutex> lk(worker.fMutex);
+         // The unpacker moved to a different frame while we were decoding, so this one is not needed
+         if (generation != worker.fGeneration)
+            continue;
+
+         worker.fHitEndOfFile = !frame.fIsValid;
+         worker.fFrames.push_back(std::move(frame));
+      }
+      worker.fCondition.notify_all();
+   }
+}
+
+/**
+ * Block until the worker for fileIdx has decoded frameID, and return it. The frame stays
+ * in the queue until PopFrame() is called. Only the unpacker thread removes frames, and
+ * the worker only appends to the queue, so the returned reference stays valid until then.
+ */
+AtGRAWUnpacker::DecodedFrame &AtGRAWUnpacker::WaitForFrame(Int_t fileIdx, Int_t frameID)
+{
+   auto &worker = *fWorkers[fileIdx];
+   std::unique_lock<std::mutex> lk(worker.fMutex);
+
+   // Frames are normally requested in order. If not, throw away what was decoded and restart the worker.
+   if (frameID != worker.fExpectedFrameID) {
+      LOG(debug) << "Restarting worker " << fileIdx << " at frame " << frameID;
+      worker.fFrames.clear();
+      worker.fNextFrameID = frameID;
+      worker.fExpectedFrameID = frameID;
+      worker.fHitEndOfFile = false;
+      worker.fGeneration++;
+      worker.fCondition.notify_all();
+   }
+
+   worker.fCondition.wait(lk, [&worker] { return !worker.fFrames.empty(); });
+   return worker.fFrames.front();
 }
+
+void AtGRAWUnpacker::PopFrame(Int_t fileIdx)
+{
+   auto &worker = *fWorkers[fileIdx];
+   {
+      std::lock_guard<std::mutex> lk(worker.fMutex);
+      // Let the worker keep going past the end of the file if the unpacker does
+      if (!worker.fFrames.front().fIsValid)
+         worker.fHitEndOfFile = false;
+      worker.fFrames.pop_front();
+      worker.fExpectedFrameID++;
+   }
+   worker.fCondition.notify_all();
+}
+
 void AtGRAWUnpacker::SetPseudoTopologyFrame(Int_t asadMask, Bool_t check)
 {
    for (auto &decoder : fDecoder)
@@ -6,19 +6,27 @@
  * Current version: Adam Anthony
  *
  * Input is a text file with a different GRAW file on each line.
+ *
+ * For separated data, each file is decoded by its own persistent worker thread that runs
+ * up to fPrefetchDepth frames ahead of the event currently being unpacked. Each worker
+ * fills its pads into a private buffer which are moved into the AtRawEvent once per event.
  */
 
 #ifndef _ATGRAWUNPACKER_H_
 #define _ATGRAWUNPACKER_H_
 
+#include "AtPad.h"
 #include "AtUnpacker.h"
 
 #include <Rtypes.h>
 #include <TString.h>
 
+#include <condition_variable>
+#include <deque>
 #include <memory>
 #include <mutex>
 #include <string>
+#include <thread>
 #include <vector>
 
 class GETLayeredFrame;
@@ -35,6 +43,27 @@ using AtPedestalPtr = std::unique_ptr<AtPedestal>;
 
 class AtGRAWUnpacker : public AtUnpacker {
 protected:
+   // A frame decoded into pads by one of the file workers
+   struct DecodedFrame {
+      Int_t fFrameID{-1};
+      Int_t fEventID{-1};
+      Bool_t fIsValid{false}; // False if the frame does not exist in the file
+      std::vector<std::unique_ptr<AtPad>> fPads;
+   };
+
+   // Persistent thread decoding the frames of a single file ahead of the unpacker
+   struct FileWorker {
+      std::thread fThread;
+      std::mutex fMutex;
+      std::condition_variable fCondition;
+      std::deque<DecodedFrame> fFrames; // Decoded frames in order, waiting to be merged into an event
+      Int_t fNextFrameID{0};            // Next frame for the worker to decode
+      Int_t fExpectedFrameID{0};        // Next frame the unpacker is expected to ask for
+      Int_t fGeneration{0};             // Incremented every time the worker is moved to a new frame
+      Bool_t fHitEndOfFile{false};
+      Bool_t fIsStopped{false};
+   };
+
    // Number of unique graw files (cobo or asad) to unpack.
    // Each has its own GETDecoder2, and AtPedestal instance and we will spawn fNumFiles
    // threads to unpack them in parallel
@@ -48,26 +77,36 @@ protected:
    Bool_t fIsData = false;
    Bool_t fIsNegativePolarity = true;
    Bool_t fIsSeparatedData;
+   Bool_t fUseMappedFiles = false;
 
    // String to identify which file in fInputFileName map to which fDecoder
    std::string fFileIDString;
    std::mutex fRawEventMutex;
 
+   Int_t fPrefetchDepth{4};                            // Number of frames each worker can decode ahead
+   std::vector<std::unique_ptr<FileWorker>> fWorkers; //!
+
    Int_t fTargetFrameID{}; // fDataEventID
 
 public:
    AtGRAWUnpacker(mapPtr map, Int_t numGrawFiles = 4);
-   ~AtGRAWUnpacker() = default;
+   ~AtGRAWUnpacker();
 
    // Getters
    Double_t GetFPNSigmaThreshold() const { return fFPNSigmaThreshold; }
    Bool_t GetIsPositivePolarity() const { return !fIsNegativePolarity; }
    Bool_t GetIsSeparatedData() const { return fIsSeparatedData; }
+   Bool_t GetUseMappedFiles() const { return fUseMappedFiles; }
+   Int_t GetPrefetchDepth() const { return fPrefetchDepth; }
 
    // Setters
    void SetFPNSigmaThreshold(Double_t val) { fFPNSigmaThreshold = val; }
    void SetIsPositivePolarity(Bool_t val) { fIsNegativePolarity = !val; }
    void SetPseudoTopologyFrame(Int_t asadMask, Bool_t check);
+   // Read GRAW files through memory maps and a cached frame index (see GETMappedFile)
+   void SetUseMappedFiles(Bool_t val) { fUseMappedFiles = val; }
+   // Number of frames ahead of the current event each file is decoded (separated data only)
+   void SetPrefetchDepth(Int_t depth) { fPrefetchDepth = depth < 1 ? 1 : depth; }
 
    // AtUnpacker interface
    virtual void Init() override;
@@ -78,14 +117,19 @@ public:
 
 private:
    virtual Long64_t GetNumEvents() override { return -1; }
-   Int_t GetFPNChannel(Int_t chIdx);
 
    void processInputFile();
 
    Bool_t AddData(TString filename, Int_t fileIdx);
 
    void ProcessFile(Int_t fileIdx);
-   void ProcessBasicFile(Int_t fileIdx);
+   DecodedFrame DecodeBasicFile(Int_t fileIdx, Int_t frameID);
+
+   void StartWorkers(Int_t frameID);
+   void StopWorkers();
+   void RunWorker(Int_t fileIdx);
+   DecodedFrame &WaitForFrame(Int_t fileIdx, Int_t frameID);
+   void PopFrame(Int_t fileIdx);
    void ProcessLayeredFrame(GETLayeredFrame *layeredFrame);
    void ProcessBasicFrame(GETBasicFrame *basicFrame);
 
@@ -19,8 +19,10 @@
 #include <H5Ppublic.h>
 
 #include <cstdint>
+#include <future>
 #include <iostream>
 #include <memory>
+#include <tuple>
 #include <type_traits>
 #include <utility>
 
@@ -46,6 +48,31 @@ void AtHDFUnpacker::FillRawEvent(AtRawEvent &event)
 {
    LOG(debug) << " Unpacking event ID: " << fEventID << " with internal ID " << fDataEventID;
    fRawEvent = &event;
+
+   // Take the prefetched event, if there is one, and read the event ourselves if it is not the one we want.
+   // The file is only touched by one thread at a time: the background read is always finished here.
+   EventData recycled;
+   if (fNextEventData.valid()) {
+      recycled = std::move(fEventData);
+      fEventData = fNextEventData.get();
+   }
+   if (fEventData.fDataEventID != fDataEventID) {
+      fEventData.fDataEventID = fDataEventID;
+      readEvent(fEventData);
+   }
+
+   // Read the next event while this one is unpacked, reusing the buffers of the previous event
+   if (fUsePrefetch && fDataEventID < fLastEvent) {
+      recycled.fDataEventID = fDataEventID + 1;
+      fNextEventData = std::async(
+         std::launch::async,
+         [this](EventData next) {
+            readEvent(next);
+            return next;
+         },
+         std::move(recycled));
+   }
+
    setEventIDAndTimestamps();
    processData();
 
@@ -63,10 +90,19 @@ bool AtHDFUnpacker::IsLastEvent()
    return fDataEventID >= fLastEvent;
 }
 
+/// Read the header and data of the event event.fDataEventID from the file. Reuses the buffers in event.
+void AtHDFUnpacker::readEvent(EventData &event)
+{
+   TString header_name = TString::Format("evt%lld_header", event.fDataEventID);
+   get_header(header_name.Data(), event.fHeader);
+
+   TString event_name = TString::Format("evt%lld_data", event.fDataEventID);
+   std::tie(event.fNumPads, event.fPadSize) = raw_event_data(event_name.Data(), event.fData);
+}
+
 void AtHDFUnpacker::setEventIDAndTimestamps()
 {
-   TString header_name = TString::Format("evt%lld_header", fDataEventID);
-   auto header = get_header(header_name.Data());
+   const auto &header = fEventData.fHeader;
 
    fRawEvent->SetEventID(fEventID);
 
@@ -76,18 +112,12 @@ void AtHDFUnpacker::setEventIDAndTimestamps()
 }
 void AtHDFUnpacker::processData()
 {
-   TString event_name = TString::Format("evt%lld_data", fDataEventID);
-   std::size_t npads = n_pads(event_name.Data());
-
-   for (auto ipad = 0; ipad < npads; ++ipad)
-      processPad(ipad);
-
-   end_raw_event(); // Close dataset
+   for (std::size_t ipad = 0; ipad < fEventData.fNumPads; ++ipad)
+      processPad(fEventData.fData.data() + ipad * fEventData.fPadSize);
 }
 
-void AtHDFUnpacker::processPad(std::size_t ipad)
+void AtHDFUnpacker::processPad(const int16_t *rawadc)
 {
-   std::vector<int16_t> rawadc = pad_raw_data(ipad);
    AtPadReference PadRef = {rawadc[0], rawadc[1], rawadc[2], rawadc[3]};
 
    auto pad = createPadAndSetIsAux(PadRef);
@@ -104,17 +134,19 @@ AtPad *AtHDFUnpacker::createPadAndSetIsAux(const AtPadReference &padRef)
       return fRawEvent->AddPad(padNumber);
    }
 }
-void AtHDFUnpacker::setAdc(AtPad *pad, const std::vector<int16_t> &data)
+void AtHDFUnpacker::setAdc(AtPad *pad, const int16_t *data)
 {
    auto baseline = getBaseline(data);
+   auto &rawAdc = pad->GetRawADCBuffer();
+   auto &adc = pad->GetADCBuffer();
    for (Int_t iTb = 0; iTb < 512; iTb++) {
-      pad->SetRawADC(iTb, data.at(iTb + 5)); // First 5 words are electronic id
-      pad->SetADC(iTb, data.at(iTb + 5) - baseline);
+      rawAdc[iTb] = data[iTb + 5]; // First 5 words are electronic id
+      adc[iTb] = data[iTb + 5] - baseline;
    }
    pad->SetPedestalSubtracted(fIsBaseLineSubtraction);
 }
 
-Float_t AtHDFUnpacker::getBaseline(const std::vector<int16_t> &data)
+Float_t AtHDFUnpacker::getBaseline(const int16_t *data)
 {
    Float_t baseline = 0;
 
@@ -127,7 +159,7 @@ Float_t AtHDFUnpacker::getBaseline(const std::vector<int16_t> &data)
 }
 void AtHDFUnpacker::setDimensions(AtPad *pad)
 {
-   auto PadCenterCoord = fMap->CalcPadCenter(pad->GetPadNum());
+   auto PadCenterCoord = fMap->GetPadCenter(pad->GetPadNum());
    Int_t pSizeID = fMap->GetPadSize(pad->GetPadNum());
    pad->SetPadCoord(PadCenterCoord);
    pad->SetSizeID(pSizeID);
@@ -175,6 +207,7 @@ std::tuple<hid_t, std::vector<hsize_t>> AtHDFUnpacker::open_dataset(hid_t locId,
       int n_dims = H5Sget_simple_extent_ndims(dspaceId);
       hsize_t dims[n_dims];
       H5Sget_simple_extent_dims(dspaceId, dims, nullptr);
+      H5Sclose(dspaceId);
       std::vector<hsize_t> v_dims(dims, dims + n_dims);
       return std::make_tuple(datasetId, v_dims);
    } else {
@@ -252,52 +285,44 @@ std::string AtHDFUnpacker::get_event_name(std::size_t idx)
    }
 }
 
-std::vector<uint64_t> AtHDFUnpacker::get_header(std::string headerName)
+void AtHDFUnpacker::get_header(std::string headerName, std::vector<uint64_t> &header)
 {
-   std::vector<uint64_t> retVec;
+   header.clear();
 
    auto dataset_dims = open_dataset(_group, headerName.c_str());
-   if (std::get<0>(dataset_dims) == 0)
-      return retVec;
-
-   _dataset = std::get<0>(dataset_dims);
+   auto datasetId = std::get<0>(dataset_dims);
+   if (datasetId == 0)
+      return;
 
    // Get the length of the header
    auto len = std::get<1>(dataset_dims).at(0);
 
-   retVec.resize(len);
-   // auto *data = new uint64_t[len];
-   H5Dread(_dataset, H5T_NATIVE_ULONG, H5S_ALL, H5S_ALL, H5P_DEFAULT, retVec.data());
-
-   close_dataset(_dataset);
-   // Add read data to the vector and return it
-   // for (int i = 0; i < len; ++i)
-   // retVec.push_back(data[i]);
-
-   // delete[] data;
+   header.resize(len);
+   H5Dread(datasetId, H5T_NATIVE_ULONG, H5S_ALL, H5S_ALL, H5P_DEFAULT, header.data());
 
-   return retVec;
+   close_dataset(datasetId);
 }
 
-std::size_t AtHDFUnpacker::n_pads(std::string i_raw_event)
+std::tuple<std::size_t, std::size_t> AtHDFUnpacker::raw_event_data(std::string i_raw_event, std::vector<int16_t> &data)
 {
-   std::string dataset_name = i_raw_event;
-   auto dataset_dims = open_dataset(_group, dataset_name.c_str());
-   if (std::get<0>(dataset_dims) == 0)
-      return 0;
-   _dataset = std::get<0>(dataset_dims);
-   return std::get<1>(dataset_dims)[0];
-}
+   auto dataset_dims = open_dataset(_group, i_raw_event.c_str());
+   auto datasetId = std::get<0>(dataset_dims);
+   if (datasetId == 0)
+      return {0, 0};
+
+   auto &dims = std::get<1>(dataset_dims);
+   if (dims.size() != 2 || dims[1] < 517) {
+      LOG(error) << "Dataset " << i_raw_event << " does not have the expected shape (npads x 517)";
+      close_dataset(datasetId);
+      return {0, 0};
+   }
 
-std::vector<int16_t> AtHDFUnpacker::pad_raw_data(std::size_t i_pad)
-{
-   int16_t data[517];
-   hsize_t counts[2] = {1, 517};
-   hsize_t offsets[2] = {i_pad, 0};
-   hsize_t dims_out[2] = {1, 517};
-   read_slab<int16_t>(_dataset, counts, offsets, dims_out, data);
-   std::vector<int16_t> datav(data, data + 517);
-   return datav;
+   // Read every pad in the event at once
+   data.resize(dims[0] * dims[1]);
+   H5Dread(datasetId, H5T_NATIVE_INT16, H5S_ALL, H5S_ALL, H5P_DEFAULT, data.data());
+
+   close_dataset(datasetId);
+   return {dims[0], dims[1]};
 }
 
 /*std::size_t AtHDFUnpacker::inievent()
@@ -327,11 +352,6 @@ herr_t AtHDFUnpacker::file_info(hid_t loc_id, const char *name, const H5L_info_t
    return 0;
 }
 
-void AtHDFUnpacker::end_raw_event()
-{
-   close_dataset(_dataset);
-}
-
 void AtHDFUnpacker::close()
 {
    close_group(_group);
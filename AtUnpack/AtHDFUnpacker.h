@@ -18,6 +18,7 @@
 #include <stdint.h>
 
 #include <cstddef>
+#include <future>
 #include <string>
 #include <tuple>
 #include <vector>
@@ -32,23 +33,37 @@ class TMemberInspector;
 class AtHDFUnpacker : public AtUnpacker {
 
 private:
+   // Everything read from the file for a single event
+   struct EventData {
+      Long64_t fDataEventID{-1};
+      std::vector<uint64_t> fHeader;
+      std::vector<int16_t> fData; ///< Traces of every pad in the event, fPadSize words per pad
+      std::size_t fNumPads{0};
+      std::size_t fPadSize{0};
+   };
+
    Int_t fNumberTimestamps{};
    Bool_t fIsBaseLineSubtraction{};
+   Bool_t fUsePrefetch{false};
 
    hid_t _file{};
    hid_t _group{};
-   hid_t _dataset{};
    std::vector<std::string> _eventsbyname;
 
    std::size_t fFirstEvent{};
    std::size_t fLastEvent{};
 
+   EventData fEventData;                  //! Event being unpacked (buffers are reused between events)
+   std::future<EventData> fNextEventData; //! Next event being read in the background
+
 public:
    AtHDFUnpacker(mapPtr map);
    ~AtHDFUnpacker() = default;
 
    void SetBaseLineSubtraction(Bool_t value) { fIsBaseLineSubtraction = value; }
    void SetNumberTimestamps(int numTimestamps) { fNumberTimestamps = numTimestamps; };
+   /// If true, the next event is read from the file on a background thread while the current one is unpacked
+   void SetPrefetch(Bool_t value) { fUsePrefetch = value; }
 
    void Init() override;
    void FillRawEvent(AtRawEvent &event) override;
@@ -56,13 +71,14 @@ public:
    Long64_t GetNumEvents() override;
 
 private:
+   void readEvent(EventData &event);
    void setEventIDAndTimestamps();
    void processData();
-   void processPad(std::size_t padIndex);
+   void processPad(const int16_t *data);
    AtPad *createPadAndSetIsAux(const AtPadReference &padRef);
    void setDimensions(AtPad *pad);
-   Float_t getBaseline(const std::vector<int16_t> &data);
-   void setAdc(AtPad *pad, const std::vector<int16_t> &data);
+   Float_t getBaseline(const int16_t *data);
+   void setAdc(AtPad *pad, const int16_t *data);
 
    enum class IO_MODE { READ, WRITE };
 
@@ -75,29 +91,17 @@ private:
    void close_group(hid_t group);
    void close_dataset(hid_t dataset);
 
-   template <typename T>
-   void read_slab(hid_t dataset, hsize_t *counts, hsize_t *offsets, hsize_t *dims_out, T *data)
-   {
-      hid_t dataspace = H5Dget_space(dataset);
-      H5Sselect_hyperslab(dataspace, H5S_SELECT_SET, offsets, nullptr, counts, nullptr);
-      hid_t memspace = H5Screate_simple(2, dims_out, nullptr);
-      H5Dread(dataset, H5T_NATIVE_INT16, memspace, dataspace, H5P_DEFAULT, data);
-      H5Sclose(memspace);
-      H5Sclose(dataspace);
-   }
-
    // Following methods satisfy the data_handler interface
    std::size_t open(char const *file);
-   std::size_t n_pads(std::string i_raw_event);
-   std::vector<int16_t> pad_raw_data(std::size_t i_pad);
-   std::vector<uint64_t> get_header(std::string headerName);
+   // Read the whole dataset of an event into data (resized as needed). Returns the number of pads and words per pad
+   std::tuple<std::size_t, std::size_t> raw_event_data(std::string i_raw_event, std::vector<int16_t> &data);
+   void get_header(std::string headerName, std::vector<uint64_t> &header);
    std::size_t datasets();
    static herr_t file_info(hid_t loc_id, const char *name, const H5L_info_t *linfo, void *opdata);
-   void end_raw_event();
    void close();
    std::string get_event_name(std::size_t idx);
 
-   ClassDefOverride(AtHDFUnpacker, 1);
+   ClassDefOverride(AtHDFUnpacker, 2);
 };
 
 #endif
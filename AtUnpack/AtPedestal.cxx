@@ -14,51 +14,117 @@
 
 #include <Rtypes.h>
 
-#include "GETMath2.h"
-
 #include <iostream>
 
 ClassImp(AtPedestal);
 
-AtPedestal::AtPedestal() : fMath(std::make_unique<GETMath2>()) {}
-
-Bool_t AtPedestal::SubtractPedestal(Int_t numTbs, Int_t *fpn, Int_t *rawADC, Double_t *dest, Double_t rmsCut,
-                                    Bool_t signalNegativePolarity, Int_t startTb, Int_t averageTbs)
+namespace {
+/**
+ * Find the first window of averageTbs time buckets, starting at startTb and stepping by averageTbs,
+ * whose RMS is below rmsCut. The sums are done in integers so the result does not depend on the order
+ * the samples are added in. Returns the first time bucket of the window or -1 if there is none.
+ */
+Int_t FindBaselineWindow(const Int_t *rawADC, Int_t numTbs, Double_t rmsCut, Int_t startTb, Int_t averageTbs,
+                         Double_t &mean)
 {
+   const Double_t rmsCut2 = rmsCut * rmsCut;
    while (true) {
-      fMath->Reset();
-      for (Int_t iTb = startTb; iTb < startTb + averageTbs; iTb++)
-         fMath->Add(rawADC[iTb]);
+      Long64_t sum = 0;
+      Long64_t sum2 = 0;
+      for (Int_t iTb = startTb; iTb < startTb + averageTbs; iTb++) {
+         sum += rawADC[iTb];
+         sum2 += static_cast<Long64_t>(rawADC[iTb]) * rawADC[iTb];
+      }
 
-      if (fMath->GetRMS() < rmsCut)
-         break;
+      // Population variance, same as GETMath2::GetRMS()
+      mean = Double_t(sum) / averageTbs;
+      Double_t var = Double_t(averageTbs * sum2 - sum * sum) / (Double_t(averageTbs) * averageTbs);
+      if (var < rmsCut2)
+         return startTb;
 
       startTb += averageTbs;
-
-      if (startTb > numTbs - averageTbs - 3) {
-         std::cout << "= [STPedestal] There's no part satisfying sigma threshold " << rmsCut << "!" << std::endl;
-
-         return kFALSE;
-      }
+      if (startTb > numTbs - averageTbs - 3)
+         return -1;
    }
+}
 
-   Double_t baselineDiff = -fMath->GetMean();
-
-   fMath->Reset();
+Double_t GetWindowMean(const Int_t *adc, Int_t startTb, Int_t averageTbs)
+{
+   Long64_t sum = 0;
    for (Int_t iTb = startTb; iTb < startTb + averageTbs; iTb++)
-      fMath->Add(fpn[iTb]);
+      sum += adc[iTb];
+   return Double_t(sum) / averageTbs;
+}
 
-   baselineDiff += fMath->GetMean();
+/**
+ * dest = sign * (raw - (fpn - baselineDiff)). Kept branch-free over contiguous arrays so the compiler
+ * vectorizes it.
+ */
+void SubtractFPN(const Int_t *__restrict fpn, const Int_t *__restrict rawADC, Double_t *__restrict dest,
+                 Int_t numTbs, Double_t baselineDiff, Bool_t signalNegativePolarity)
+{
+   const Double_t sign = signalNegativePolarity ? -1 : 1;
+   const Double_t offset = sign * baselineDiff;
+   for (Int_t iTb = 0; iTb < numTbs; iTb++)
+      dest[iTb] = sign * (rawADC[iTb] - fpn[iTb]) + offset;
+}
 
-   for (Int_t iTb = 0; iTb < numTbs; iTb++) {
-      Double_t adc = 0;
-      if (signalNegativePolarity == kTRUE)
-         adc = (fpn[iTb] - baselineDiff) - rawADC[iTb];
-      else
-         adc = rawADC[iTb] - (fpn[iTb] - baselineDiff);
+void PrintNoBaseline(Double_t rmsCut)
+{
+   std::cout << "= [STPedestal] There's no part satisfying sigma threshold " << rmsCut << "!" << std::endl;
+}
+} // namespace
 
-      dest[iTb] = adc;
+Bool_t AtPedestal::SubtractPedestal(Int_t numTbs, Int_t *fpn, Int_t *rawADC, Double_t *dest, Double_t rmsCut,
+                                    Bool_t signalNegativePolarity, Int_t startTb, Int_t averageTbs)
+{
+   Double_t rawMean = 0;
+   startTb = FindBaselineWindow(rawADC, numTbs, rmsCut, startTb, averageTbs, rawMean);
+   if (startTb < 0) {
+      PrintNoBaseline(rmsCut);
+      return kFALSE;
    }
 
+   Double_t baselineDiff = GetWindowMean(fpn, startTb, averageTbs) - rawMean;
+   SubtractFPN(fpn, rawADC, dest, numTbs, baselineDiff, signalNegativePolarity);
+
    return kTRUE;
 }
+
+Int_t AtPedestal::SubtractPedestal(const Int_t *agetSamples, const std::array<Double_t *, kNumChannels> &dest,
+                                   Double_t rmsCut, Bool_t signalNegativePolarity, Int_t startTb, Int_t averageTbs,
+                                   Int_t numTbs)
+{
+   Int_t numFailed = 0;
+   for (Int_t iCh = 0; iCh < kNumChannels; iCh++) {
+      if (dest[iCh] == nullptr)
+         continue;
+
+      const Int_t *rawADC = agetSamples + iCh * numTbs;
+      const Int_t *fpn = agetSamples + GetFPNChannel(iCh) * numTbs;
+
+      Double_t rawMean = 0;
+      Int_t windowTb = FindBaselineWindow(rawADC, numTbs, rmsCut, startTb, averageTbs, rawMean);
+      if (windowTb < 0) {
+         PrintNoBaseline(rmsCut);
+         numFailed++;
+         continue;
+      }
+
+      Double_t baselineDiff = GetWindowMean(fpn, windowTb, averageTbs) - rawMean;
+      SubtractFPN(fpn, rawADC, dest[iCh], numTbs, baselineDiff, signalNegativePolarity);
+   }
+
+   return numFailed;
+}
+
+Int_t AtPedestal::GetFPNChannel(Int_t chIdx)
+{
+   if (chIdx < 17)
+      return 11;
+   if (chIdx < 34)
+      return 22;
+   if (chIdx < 51)
+      return 45;
+   return 56;
+}
@@ -16,9 +16,7 @@
 #include <Rtypes.h>
 #include <TObject.h>
 
-#include "GETMath2.h"
-
-#include <memory>
+#include <array>
 
 class TBuffer;
 class TClass;
@@ -26,15 +24,28 @@ class TMemberInspector;
 
 class AtPedestal : public TObject {
 public:
-   AtPedestal();
+   static constexpr Int_t kNumChannels = 68; ///< Channels in one AGET chip (including FPN channels)
+
+   AtPedestal() = default;
 
    Bool_t SubtractPedestal(Int_t numTbs, Int_t *fpn, Int_t *rawADC, Double_t *dest, Double_t rmsCut = 5,
                            Bool_t signalNegativePolarity = kFALSE, Int_t startTb = 3, Int_t averageTbs = 10);
 
-private:
-   std::unique_ptr<GETMath2> fMath;
-
-   ClassDef(AtPedestal, 1);
+   /**
+    * Subtract the pedestal of every channel of one AGET chip in a single call.
+    * **agetSamples** is the numTbs*68 samples of the chip stored channel after channel (the layout
+    * of GETBasicFrame::GetSample(agetIdx, 0)). The corrected trace of channel i is written to dest[i];
+    * channels with a null destination are skipped. Returns the number of channels where no baseline
+    * window satisfied the RMS cut (their destination is left untouched).
+    */
+   Int_t SubtractPedestal(const Int_t *agetSamples, const std::array<Double_t *, kNumChannels> &dest,
+                          Double_t rmsCut = 5, Bool_t signalNegativePolarity = kFALSE, Int_t startTb = 3,
+                          Int_t averageTbs = 10, Int_t numTbs = 512);
+
+   /// FPN channel used to correct the channel **chIdx** of an AGET chip
+   static Int_t GetFPNChannel(Int_t chIdx);
+
+   ClassDef(AtPedestal, 2);
 };
 
 #endif
@@ -16,6 +16,7 @@
 #include <TTreeReaderArray.h>
 #include <TTreeReaderValue.h>
 
+#include <algorithm>
 #include <iostream>
 #include <string>
 #include <utility>
@@ -25,12 +26,16 @@ constexpr auto cYELLOW = "\033[1;33m";
 constexpr auto cNORMAL = "\033[0m";
 constexpr auto cGREEN = "\033[1;32m";
 
+AtROOTUnpacker::AtROOTUnpacker() : AtUnpacker(nullptr) {}
+
 AtROOTUnpacker::AtROOTUnpacker(mapPtr map, Int_t numCobo)
    : AtUnpacker(map), fNumCobo(numCobo), fIsNegativePolarity(numCobo, false), fIsPadPlaneCobo(numCobo, false),
      fFPNChannels(numCobo), fPedestal(new AtPedestal())
 {
 }
 
+AtROOTUnpacker::~AtROOTUnpacker() = default;
+
 void AtROOTUnpacker::SetIsPadPlaneCobo(vecBool vec)
 {
    if (vec.size() != fNumCobo) {
@@ -52,183 +57,125 @@ void AtROOTUnpacker::FillRawEvent(AtRawEvent &event)
 {
    event.Clear();
    LOG(info) << "Start processing event " << fDataEventID;
+   auto channels = ReadEvent(fDataEventID);
    LOG(info) << "Getting fpn channels ";
-   GetFPNChannelsFromROOTFILE();
+   GetFPNChannelsFromROOTFILE(channels);
    LOG(info) << "finished getting event from root file";
-   ProcessROOTFILE(event);
+   ProcessROOTFILE(event, channels);
 
    event.SetEventID(fEventID);
    fEventID++;
    fDataEventID++;
 }
 
-// type = 0 for padplane pads
-// type = 1 for scintillators
-// for padplane the channels 11,22,45 & 56 are used as fpn channels
-// for scintillators 43,44,46 & 47 are used
-void AtROOTUnpacker::GetFPNChannelsFromROOTFILE()
+bool AtROOTUnpacker::OpenInputFile()
 {
-
-   Int_t type{0};
-   std::vector<int> ChannelsFPNpp = {11, 22, 45, 56}; // fpn channels for
-                                                      // padplane
-   std::vector<int> ChannelsFPNsc = {43, 44, 46, 47}; // fpn channels for scintillators
-   Int_t Nr_fpn_found{0};
-
+   fRawDataTree = nullptr;
    LOG(debug) << "Opening " << fInputFileName;
-   auto *RawDataTreeFile = new TFile(fInputFileName.data(), "READ"); // NOLINT (belongs to ROOT)
-   if (RawDataTreeFile->IsZombie()) {
+   fFile = std::make_unique<TFile>(fInputFileName.data(), "READ");
+   if (fFile->IsZombie()) {
       std::cout << cRED
                 << "[AtCoreSpecMAT] File containing tree not found, check if "
                    "input file name is correct ("
                 << fInputFileName << ")" << cNORMAL << std::endl;
-      return;
+      return false;
    }
-   auto *RawDataTree = dynamic_cast<TTree *>(RawDataTreeFile->Get("EventDataTree"));
-   if (!RawDataTree) {
+   fRawDataTree = dynamic_cast<TTree *>(fFile->Get("EventDataTree"));
+   if (!fRawDataTree) {
       std::cout << cRED
                 << "[AtCoreSpecMAT] File does not contain raw data ttree (must "
                    "be named EventDataTree)"
                 << cNORMAL << std::endl;
       std::cout << "Input file " << fInputFileName << " contains: " << std::endl;
-      RawDataTreeFile->ls();
-      return;
+      fFile->ls();
+      return false;
    }
+   return true;
+}
 
-   // Read the raw data tree
-   TTreeReader myReader(RawDataTree);
+/// Read every entry of the raw data tree belonging to the event, using the index built by SetNumEvents
+std::vector<AtROOTUnpacker::RawChannel> AtROOTUnpacker::ReadEvent(Int_t internalEventNr)
+{
+   std::vector<RawChannel> channels;
+   auto ranges = fEventEntries.find(internalEventNr);
+   if (fRawDataTree == nullptr || ranges == fEventEntries.end())
+      return channels;
 
-   // setting reader addresses
-   TTreeReaderValue<Int_t> myInternalEventNr(myReader, "InternalEventNr");
+   TTreeReader myReader(fRawDataTree);
    TTreeReaderValue<UChar_t> myCoboNr(myReader, "CoboNr");
    TTreeReaderValue<UChar_t> myAsadNr(myReader, "AsadNr");
    TTreeReaderValue<UChar_t> myAgetNr(myReader, "AgetNr");
    TTreeReaderValue<UChar_t> myChannelNr(myReader, "ChannelNr");
    TTreeReaderArray<UShort_t> mySamples(myReader, "Samples");
 
-   // Fill vectors
-   Bool_t EventCompleted = false;
-   while (myReader.Next() && (!EventCompleted)) {
-      if (*myInternalEventNr == fDataEventID) {
-         AtPadReference PadRef = {*myCoboNr, *myAsadNr, *myAgetNr, *myChannelNr};
-         for (Int_t i = 0; i < 4; i++) { // loop over number of fpn channels
-            if ((PadRef.ch == ChannelsFPNpp[i]) && fIsPadPlaneCobo[PadRef.cobo]) {
-               Nr_fpn_found++;
-               // std::cout << "Added fpnchannel" << std::endl;
-               // std::cout << ", corresponding to Cobo: " << PadRef[0] << "   Asad:
-               // "  << PadRef[1] << "   Aget: "  << PadRef[2] << "   Ch: "  <<
-               // PadRef[3] << std::endl;
-               for (Int_t j = 0; j < 512; j++) {
-                  fFPNChannels[PadRef.cobo][PadRef.asad][PadRef.aget][i][j] = mySamples[j];
-               }
-            } else if ((PadRef.ch == ChannelsFPNsc[i]) && !(fIsPadPlaneCobo[PadRef.cobo])) {
-               Nr_fpn_found++;
-               // std::cout << "Added fpnchannel" << std::endl;
-               // std::cout << ", corresponding to Cobo: " << PadRef[0] << "   Asad:
-               // "  << PadRef[1] << "   Aget: "  << PadRef[2] << "   Ch: "  <<
-               // PadRef[3] << std::endl;
-               for (Int_t j = 0; j < 512; j++) {
-                  fFPNChannels[PadRef.cobo][PadRef.asad][PadRef.aget][i][j] = mySamples[j];
-               }
-            }
-         }
-
-      } else if (*myInternalEventNr > fDataEventID) {
-         EventCompleted = true;
+   for (const auto &[begin, end] : ranges->second) {
+      myReader.SetEntriesRange(begin, end);
+      while (myReader.Next()) {
+         RawChannel channel{{*myCoboNr, *myAsadNr, *myAgetNr, *myChannelNr}, std::vector<Int_t>(512, 0)};
+         std::copy_n(mySamples.begin(), std::min<std::size_t>(mySamples.GetSize(), 512), channel.fSamples.begin());
+         channels.push_back(std::move(channel));
       }
    }
-   std::cout << "A total of " << Nr_fpn_found << " fpn channels were found for event nr " << fDataEventID << std::endl;
+   return channels;
 }
 
-void AtROOTUnpacker::ProcessROOTFILE(AtRawEvent &eventToFill)
+// type = 0 for padplane pads
+// type = 1 for scintillators
+// for padplane the channels 11,22,45 & 56 are used as fpn channels
+// for scintillators 43,44,46 & 47 are used
+void AtROOTUnpacker::GetFPNChannelsFromROOTFILE(const std::vector<RawChannel> &channels)
 {
+   std::vector<int> ChannelsFPNpp = {11, 22, 45, 56}; // fpn channels for
+                                                      // padplane
+   std::vector<int> ChannelsFPNsc = {43, 44, 46, 47}; // fpn channels for scintillators
+   Int_t Nr_fpn_found{0};
 
-   auto *RawDataTreeFile = new TFile(fInputFileName.data(), "READ"); // NOLINT (belongs to ROOT)
-   if (RawDataTreeFile->IsZombie()) {
-      std::cout << cRED
-                << "[AtCoreSpecMAT] File containing tree not found, check if "
-                   "input file name is correct ("
-                << fInputFileName << ")" << cNORMAL << std::endl;
-      return;
-   }
-   auto *RawDataTree = dynamic_cast<TTree *>(RawDataTreeFile->Get("EventDataTree"));
-   if (!RawDataTree) {
-      std::cout << cRED
-                << "[AtCoreSpecMAT] File does not contain raw data ttree (must "
-                   "be named EventDataTree)"
-                << cNORMAL << std::endl;
-      return;
+   for (const auto &channel : channels) {
+      const auto &PadRef = channel.fRef;
+      for (Int_t i = 0; i < 4; i++) { // loop over number of fpn channels
+         auto isFPN = fIsPadPlaneCobo[PadRef.cobo] ? PadRef.ch == ChannelsFPNpp[i] : PadRef.ch == ChannelsFPNsc[i];
+         if (isFPN) {
+            Nr_fpn_found++;
+            std::copy_n(channel.fSamples.begin(), 512, fFPNChannels[PadRef.cobo][PadRef.asad][PadRef.aget][i]);
+         }
+      }
    }
+   std::cout << "A total of " << Nr_fpn_found << " fpn channels were found for event nr " << fDataEventID << std::endl;
+}
 
-   // Read the raw data tree
-   TTreeReader myReader(RawDataTree);
-
-   // setting reader addresses
-   TTreeReaderValue<Int_t> myInternalEventNr(myReader, "InternalEventNr");
-   TTreeReaderValue<UChar_t> myCoboNr(myReader, "CoboNr");
-   TTreeReaderValue<UChar_t> myAsadNr(myReader, "AsadNr");
-   TTreeReaderValue<UChar_t> myAgetNr(myReader, "AgetNr");
-   TTreeReaderValue<UChar_t> myChannelNr(myReader, "ChannelNr");
-   TTreeReaderArray<UShort_t> mySamples(myReader, "Samples");
-
-   // Fill vectors
-   Bool_t EventCompleted = false;
-   while (myReader.Next() && (!EventCompleted)) {
-      // std::cout << "InternalEventNr is" << *myInternalEventNr << " fDataEventID is " << fDataEventID << std::endl;
-      if (*myInternalEventNr == fDataEventID) {
-         AtPadReference PadRef = {*myCoboNr, *myAsadNr, *myAgetNr, *myChannelNr};
-         Int_t PadRefNum = fMap->GetPadNum(PadRef);
-         // std::cout << "Fired pad nr: " << PadRefNum << std::endl;
-         // std::cout << ", corresponding to Cobo: " << PadRef.cobo << "   Asad: " <<
-         // PadRef.asad << "   Aget: "  << PadRef.aget << "   Ch: "  << PadRef.ch <<
-         // std::endl;
-         auto PadCenterCoord = fMap->CalcPadCenter(PadRefNum);
-         Bool_t IsInhibited = fMap->IsInhibited(PadRefNum) != AtMap::InhibitType::kNone;
-
-         if (PadRefNum != -1 && !IsInhibited) {
-            // AtPad *pad = new ((*fPadArray)[PadRefNum]) AtPad(PadRefNum);
-            AtPad *pad = eventToFill.AddPad(PadRefNum);
-            pad->SetPadCoord(PadCenterCoord);
-
-            // std::cout << "pad coordinates are (" << PadCenterCoord[0] << ", " <<
-            // PadCenterCoord[1] << ")" << std::endl;
-
-            if ((PadRefNum == -1) || IsInhibited)
-               pad->SetValidPad(kFALSE);
-            else
-               pad->SetValidPad(kTRUE);
-
-            Int_t rawadc[512] = {0};
-            for (int i = 0; i < 512; i++) {
-               rawadc[i] = mySamples[i];
-            }
-
-            for (Int_t iTb = 0; iTb < 512; iTb++)
-               pad->SetRawADC(iTb, rawadc[iTb]);
-
-            Double_t adc[512] = {0};
-            Int_t fpn_adc[512] = {0};
-            for (int i = 0; i < 512; i++) {
-               fpn_adc[i] = (fFPNChannels[PadRef.cobo][PadRef.asad][PadRef.aget][0][i] +
-                             fFPNChannels[PadRef.cobo][PadRef.asad][PadRef.aget][1][i] +
-                             fFPNChannels[PadRef.cobo][PadRef.asad][PadRef.aget][2][i] +
-                             fFPNChannels[PadRef.cobo][PadRef.asad][PadRef.aget][3][i]) /
-                            4;
-            }
-            Bool_t good =
-               fPedestal->SubtractPedestal(512, fpn_adc, rawadc, adc, 5, fIsNegativePolarity[PadRef.cobo], 5, 20);
-            // std::cout << "Is this pad good? " << good << std::endl;
-
-            for (Int_t iTb = 0; iTb < 512; iTb++) {
-               pad->SetADC(iTb, adc[iTb]);
-               // if(iTb ==100) std::cout << "First time sample is:  " << rawadc[iTb]
-               //<<  "after subtraction  "  << adc[iTb] << std::endl;
-            }
-            pad->SetPedestalSubtracted(kTRUE);
-            eventToFill.SetIsGood(good);
+void AtROOTUnpacker::ProcessROOTFILE(AtRawEvent &eventToFill, std::vector<RawChannel> &channels)
+{
+   for (auto &channel : channels) {
+      const auto &PadRef = channel.fRef;
+      Int_t PadRefNum = fMap->GetPadNum(PadRef);
+      auto PadCenterCoord = fMap->GetPadCenter(PadRefNum);
+      Bool_t IsInhibited = fMap->IsInhibited(PadRefNum) != AtMap::InhibitType::kNone;
+
+      if (PadRefNum != -1 && !IsInhibited) {
+         AtPad *pad = eventToFill.AddPad(PadRefNum);
+         pad->SetPadCoord(PadCenterCoord);
+         pad->SetValidPad(kTRUE);
+
+         Int_t *rawadc = channel.fSamples.data();
+         for (Int_t iTb = 0; iTb < 512; iTb++)
+            pad->SetRawADC(iTb, rawadc[iTb]);
+
+         Double_t adc[512] = {0};
+         Int_t fpn_adc[512] = {0};
+         for (int i = 0; i < 512; i++) {
+            fpn_adc[i] = (fFPNChannels[PadRef.cobo][PadRef.asad][PadRef.aget][0][i] +
+                          fFPNChannels[PadRef.cobo][PadRef.asad][PadRef.aget][1][i] +
+                          fFPNChannels[PadRef.cobo][PadRef.asad][PadRef.aget][2][i] +
+                          fFPNChannels[PadRef.cobo][PadRef.asad][PadRef.aget][3][i]) /
+                         4;
          }
-      } else if (*myInternalEventNr > fDataEventID) {
-         EventCompleted = true;
+         Bool_t good =
+            fPedestal->SubtractPedestal(512, fpn_adc, rawadc, adc, 5, fIsNegativePolarity[PadRef.cobo], 5, 20);
+
+         for (Int_t iTb = 0; iTb < 512; iTb++)
+            pad->SetADC(iTb, adc[iTb]);
+         pad->SetPedestalSubtracted(kTRUE);
+         eventToFill.SetIsGood(good);
       }
    }
 }
@@ -260,33 +207,30 @@ bool AtROOTUnpacker::IsLastEvent()
    return fEventID >= GetNumEvents();
 }
 
+/**
+ * Open the input file and scan the event number of every entry once, recording the ranges of entries
+ * belonging to each event. Events are then read directly from their entries instead of searching the tree.
+ */
 void AtROOTUnpacker::SetNumEvents()
 {
-   auto *RawDataTreeFile = new TFile(fInputFileName.data(), "READ"); // NOLINT (belongs to ROOT)
-   if (RawDataTreeFile->IsZombie()) {
-      std::cout << cRED
-                << "[AtCoreSpecMAT] File containing tree not found, check if "
-                   "input file name is correct ("
-                << fInputFileName << ")" << cNORMAL << std::endl;
-      return;
-   }
-   auto *RawDataTree = dynamic_cast<TTree *>(RawDataTreeFile->Get("EventDataTree"));
-   if (!RawDataTree) {
-      std::cout << cRED
-                << "[AtCoreSpecMAT] File does not contain raw data ttree (must "
-                   "be named EventDataTree)"
-                << cNORMAL << std::endl;
+   fEventEntries.clear();
+   fNumEvents = 0;
+   if (!OpenInputFile())
       return;
-   }
-
-   // Read the raw data tree
-   TTreeReader myReader(RawDataTree);
 
-   // setting reader addresses
+   TTreeReader myReader(fRawDataTree);
    TTreeReaderValue<Int_t> myInternalEventNr(myReader, "InternalEventNr");
-   while (myReader.Next())
+   while (myReader.Next()) {
+      auto entry = myReader.GetCurrentEntry();
+      auto &ranges = fEventEntries[*myInternalEventNr];
+      if (!ranges.empty() && ranges.back().second == entry)
+         ranges.back().second = entry + 1;
+      else
+         ranges.emplace_back(entry, entry + 1);
+
       if (*myInternalEventNr > fNumEvents)
          fNumEvents = *myInternalEventNr;
+   }
 
    --fNumEvents; // Correct for off by one
 }
@@ -7,18 +7,23 @@
 #ifndef _ATROOTUNPACKER_H_
 #define _ATROOTUNPACKER_H_
 
+#include "AtPadReference.h"
 #include "AtUnpacker.h"
 
 #include <Rtypes.h>
 
+#include <map>
 #include <memory>
+#include <utility>
 #include <vector>
 
 class AtPedestal;
 class AtRawEvent;
 class TBuffer;
 class TClass;
+class TFile;
 class TMemberInspector;
+class TTree;
 
 using vecBool = std::vector<bool>;
 using vecFPN = std::vector<Int_t[4][4][4][512]>;
@@ -37,10 +42,14 @@ protected:
    vecBool fIsNegativePolarity;
    vecFPN fFPNChannels; //! Don't write to disk (root can't handle it) [cobo][asad][aget][fpn][sample]
 
+   std::unique_ptr<TFile> fFile; //! Input file, opened once by Init
+   TTree *fRawDataTree{};        //! EventDataTree (owned by fFile)
+   std::map<Int_t, std::vector<std::pair<Long64_t, Long64_t>>> fEventEntries; //! [InternalEventNr] = [begin, end)
+
 public:
-   AtROOTUnpacker() : AtUnpacker(nullptr) {}
+   AtROOTUnpacker();
    AtROOTUnpacker(mapPtr map, Int_t numCobo = 4);
-   ~AtROOTUnpacker() = default;
+   ~AtROOTUnpacker();
 
    void Init() override;
    void FillRawEvent(AtRawEvent &event) override;
@@ -52,11 +61,19 @@ public:
    void SetIsNegativePolarity(vecBool vec);
    void SetFPNPedestalRMS(double sigma) { fFPNSigmaThreshold = sigma; }
 
-   ClassDefOverride(AtROOTUnpacker, 1);
+   ClassDefOverride(AtROOTUnpacker, 2);
 
 private:
-   void GetFPNChannelsFromROOTFILE();
-   void ProcessROOTFILE(AtRawEvent &eventToFill);
+   // One entry of the raw data tree
+   struct RawChannel {
+      AtPadReference fRef;
+      std::vector<Int_t> fSamples; ///< Always 512 samples
+   };
+
+   bool OpenInputFile();
+   std::vector<RawChannel> ReadEvent(Int_t internalEventNr);
+   void GetFPNChannelsFromROOTFILE(const std::vector<RawChannel> &channels);
+   void ProcessROOTFILE(AtRawEvent &eventToFill, std::vector<RawChannel> &channels);
    Int_t GetFPNChannel(Int_t chIdx);
    void SetNumEvents();
 };
@@ -38,6 +38,7 @@ void AtUnpackTask::Exec(Option_t *opt)
 {
    fOutputEventArray.Clear("C");
    auto rawEvent = dynamic_cast<AtRawEvent *>(fOutputEventArray.ConstructedAt(0));
+   rawEvent->SetUsePadArena(fUsePadArena);
 
    LOG(debug) << "Unpacking event: " << fUnpacker->GetNextEventID();
 
@@ -32,6 +32,7 @@ private:
    std::string fOuputBranchName = "AtRawEvent";
    Bool_t fIsPersistent = true;
    Bool_t fFinishedUnpacking = false;
+   Bool_t fUsePadArena = false;
 
    TClonesArray fOutputEventArray;
    AtRawEvent *fRawEvent;
@@ -44,6 +45,8 @@ public:
    void SetInputFileName(std::string filename) { fInputFileName = filename; }
    void SetOuputBranchName(std::string branchName) { fOuputBranchName = branchName; }
    void SetPersistence(Bool_t value) { fIsPersistent = value; }
+   /// Allocate the pads of each event in a single block reused between events (see AtRawEvent::SetUsePadArena)
+   void SetUsePadArena(Bool_t value) { fUsePadArena = value; }
 
    Long64_t GetNumEvents() { return fUnpacker->GetNumEvents(); }
 
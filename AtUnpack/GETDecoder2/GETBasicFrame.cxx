@@ -67,6 +67,46 @@ void GETBasicFrame::Read(ifstream &stream)
    stream.ignore(GetFrameSkip());
 }
 
+void GETBasicFrame::Read(const uint8_t *data)
+{
+   Clear();
+
+   GETBasicFrameHeader::Read(data);
+
+   // Samples are decoded straight from memory, skipping any extra header bytes
+   const uint8_t *item = data + GetHeaderSize();
+   const auto itemSize = GetItemSize();
+   const auto nItems = GetNItems();
+
+   if (GetFrameType() == GETFRAMEBASICTYPE1) {
+      uint8_t bytes[4];
+      for (UInt_t iItem = 0; iItem < nItems; iItem++, item += itemSize) {
+         memcpy(bytes, item, 4);
+         UInt_t word = CorrectEndianness(bytes, 4);
+
+         UShort_t agetIdx = ((word & 0xc0000000) >> 30);
+         UShort_t chIdx = ((word & 0x3f800000) >> 23);
+         UShort_t tbIdx = ((word & 0x007fc000) >> 14);
+         UShort_t sample = (word & 0x00000fff);
+
+         fSample[GetIndex(agetIdx, chIdx, tbIdx)] = sample;
+      }
+   } else if (GetFrameType() == GETFRAMEBASICTYPE2) {
+      uint8_t bytes[2];
+      for (UInt_t iItem = 0; iItem < nItems; iItem++, item += itemSize) {
+         memcpy(bytes, item, 2);
+         UShort_t word = CorrectEndianness(bytes, 2);
+
+         UShort_t agetIdx = ((word & 0xc000) >> 14);
+         UShort_t chIdx = ((iItem / 8) * 2 + iItem % 2) % 68;
+         UShort_t tbIdx = iItem / (68 * 4);
+         UShort_t sample = word & 0x0fff;
+
+         fSample[GetIndex(agetIdx, chIdx, tbIdx)] = sample;
+      }
+   }
+}
+
 UInt_t GETBasicFrame::GetIndex(Int_t agetIdx, Int_t chIdx, Int_t tbIdx)
 {
    return agetIdx * 68 * 512 + chIdx * 512 + tbIdx;
@@ -5,6 +5,8 @@
 
 #include "GETBasicFrameHeader.h"
 
+#include <stdint.h>
+
 #include <iosfwd>
 
 class TBuffer;
@@ -21,6 +23,8 @@ public:
 
    void Clear(Option_t * = "");
    void Read(ifstream &stream);
+   //! Decode the frame directly from memory (ex. a memory-mapped file) starting at **data**
+   void Read(const uint8_t *data);
 
 private:
    Int_t fSample[4 * 68 * 512];
@@ -136,6 +136,28 @@ void GETBasicFrameHeader::Read(ifstream &stream)
    stream.ignore(GetHeaderSkip());
 }
 
+void GETBasicFrameHeader::Read(const uint8_t *data)
+{
+   Clear();
+
+   GETHeaderBase::Read(data);
+   data += GETHEADERBASESIZE;
+
+   memcpy(fHeaderSize, data, 2);
+   memcpy(fItemSize, data + 2, 2);
+   memcpy(fNItems, data + 4, 4);
+   memcpy(fEventTime, data + 8, 6);
+   memcpy(fEventID, data + 14, 4);
+   memcpy(&fCoboID, data + 18, 1);
+   memcpy(&fAsadID, data + 19, 1);
+   memcpy(fReadOffset, data + 20, 2);
+   memcpy(&fStatus, data + 22, 1);
+   memcpy(fHitPat, data + 23, 4 * 9);
+   memcpy(fMultip, data + 59, 4 * 2);
+   memcpy(fWindowOut, data + 67, 4);
+   memcpy(fLastCell, data + 71, 4 * 2);
+}
+
 void GETBasicFrameHeader::Print()
 {
    cout << showbase << hex;
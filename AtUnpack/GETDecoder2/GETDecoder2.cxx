@@ -25,6 +25,7 @@
 #include "GETHeaderBase.h"
 #include "GETLayerHeader.h"
 #include "GETLayeredFrame.h"
+#include "GETMappedFile.h"
 #include "GETTopologyFrame.h"
 
 #include <algorithm>
@@ -35,6 +36,7 @@
 #include <iterator>
 #include <memory>
 #include <string>
+#include <utility>
 
 //#define DEBUG
 
@@ -136,6 +138,9 @@ void GETDecoder2::Initialize()
 
    fPrevDataID = 0;
    fPrevPosition = 0;
+
+   fUseMappedFiles = kFALSE;
+   fIsMappedIndexBuilt = kFALSE;
 }
 
 void GETDecoder2::Clear()
@@ -166,6 +171,11 @@ void GETDecoder2::Clear()
    fCoboFrame->Clear();
    fLayeredFrame->Clear();
 
+   fIsMappedIndexBuilt = kFALSE;
+   fMappedFrames.clear();
+   fMappedEventIDs.clear();
+   fMappedFiles.clear();
+
    if (fIsContinuousData) {
 
 #ifdef DEBUG
@@ -342,6 +352,9 @@ GETDecoder2::EFrameType GETDecoder2::GetFrameType()
 
 Int_t GETDecoder2::GetNumFrames()
 {
+   if (fIsMappedIndexBuilt)
+      return fMappedFrames.size();
+
    if (fIsDoneAnalyzing)
       switch (fFrameType) {
       case kBasic:
@@ -354,8 +367,91 @@ Int_t GETDecoder2::GetNumFrames()
    return -1;
 }
 
+void GETDecoder2::SetUseMappedFiles(Bool_t value)
+{
+   fUseMappedFiles = value;
+}
+
+Int_t GETDecoder2::GetFrameIDFromEventID(UInt_t eventID)
+{
+   if (fUseMappedFiles && BuildMappedIndex()) {
+      auto it = fMappedEventIDs.find(eventID);
+      return it == fMappedEventIDs.end() ? -1 : it->second;
+   }
+
+   // Only frames that have already been walked over are known when reading from the stream
+   for (Int_t iFrame = 0; iFrame < fFrameInfoArray->GetEntriesFast(); iFrame++) {
+      auto *frameInfo = (GETFrameInfo *)fFrameInfoArray->At(iFrame);
+      if (frameInfo->IsFill() && frameInfo->GetEventID() == eventID)
+         return iFrame;
+   }
+   return -1;
+}
+
+Bool_t GETDecoder2::BuildMappedIndex()
+{
+   if (fIsMappedIndexBuilt)
+      return kTRUE;
+
+   if (fCurrentDataID < 0 && !SetData(0))
+      return kFALSE;
+
+   if (fFrameType == kCobo) {
+      LOG(warn) << "== [GETDecoder] Mapped files are not supported for CoBo frames. Reading from file stream.";
+      fUseMappedFiles = kFALSE;
+      return kFALSE;
+   }
+
+   // With continuous data every file in the list is one run, otherwise only the current file is read
+   Int_t firstDataID = fIsContinuousData ? 0 : fCurrentDataID;
+   Int_t lastDataID = fIsContinuousData ? fDataList.size() - 1 : fCurrentDataID;
+   for (Int_t iData = firstDataID; iData <= lastDataID; iData++) {
+      auto file = std::make_unique<GETMappedFile>(fDataList.at(iData));
+      if (!file->LoadIndex(fFrameType != kBasic)) {
+         LOG(error) << "== [GETDecoder] Failed to map " << fDataList.at(iData) << ". Reading from file stream.";
+         fMappedFrames.clear();
+         fMappedEventIDs.clear();
+         fMappedFiles.clear();
+         fUseMappedFiles = kFALSE;
+         return kFALSE;
+      }
+
+      for (const auto &frame : file->GetIndex()) {
+         if (fFrameType != kMergedTime)
+            fMappedEventIDs.emplace(frame.fEventID, fMappedFrames.size());
+         fMappedFrames.push_back(file->GetData(frame.fStartByte));
+      }
+      fMappedFiles.push_back(std::move(file));
+   }
+
+   fIsMappedIndexBuilt = kTRUE;
+   return kTRUE;
+}
+
+const uint8_t *GETDecoder2::GetMappedFrame(Int_t frameID)
+{
+   if (frameID == -1)
+      fTargetFrameInfoIdx++;
+   else
+      fTargetFrameInfoIdx = frameID;
+
+   if (fTargetFrameInfoIdx < 0 || fTargetFrameInfoIdx >= fMappedFrames.size())
+      return nullptr;
+
+   return fMappedFrames[fTargetFrameInfoIdx];
+}
+
 GETBasicFrame *GETDecoder2::GetBasicFrame(Int_t frameID)
 {
+   if (fUseMappedFiles && BuildMappedIndex()) {
+      const uint8_t *frame = GetMappedFrame(frameID);
+      if (frame == nullptr)
+         return nullptr;
+
+      fBasicFrame->Read(frame);
+      return fBasicFrame;
+   }
+
    if (frameID == -1)
       fTargetFrameInfoIdx++;
    else
@@ -525,6 +621,15 @@ GETCoboFrame *GETDecoder2::GetCoboFrame(Int_t frameID)
 
 GETLayeredFrame *GETDecoder2::GetLayeredFrame(Int_t frameID)
 {
+   if (fUseMappedFiles && BuildMappedIndex()) {
+      const uint8_t *frame = GetMappedFrame(frameID);
+      if (frame == nullptr)
+         return nullptr;
+
+      fLayeredFrame->Read(frame);
+      return fLayeredFrame;
+   }
+
    if (frameID == -1)
       fTargetFrameInfoIdx++;
    else
@@ -16,7 +16,12 @@
 #include <Rtypes.h>
 #include <TString.h>
 
+#include "GETMappedFile.h"
+#include <stdint.h>
+
 #include <fstream>
+#include <memory>
+#include <unordered_map>
 #include <vector>
 
 class GETBasicFrame;
@@ -72,6 +77,11 @@ public:
    EFrameType GetFrameType();
 
    Int_t GetNumFrames();
+   //! Read frames directly from memory-mapped data files using a cached frame index instead of file streams.
+   //! Not supported for CoBo frames. Must be set before reading the first frame.
+   void SetUseMappedFiles(Bool_t value = kTRUE);
+   //! Return the frame number of the frame with **eventID**, or -1 if it was not found.
+   Int_t GetFrameIDFromEventID(UInt_t eventID);
    //! Return specific frame of the given frame number. If **frameID** is -1, this method returns next frame.
    GETBasicFrame *GetBasicFrame(Int_t frameID = -1);
    GETCoboFrame *GetCoboFrame(Int_t frameID = -1);
@@ -95,6 +105,10 @@ public:
 private:
    //! Initialize variables used in the class.
    void Initialize();
+   //! Map the data files and load their frame index. Returns false if the mapped files cannot be used.
+   Bool_t BuildMappedIndex();
+   //! Return a pointer to the start of the frame **frameID** in the mapped files, or nullptr if it does not exist.
+   const uint8_t *GetMappedFrame(Int_t frameID);
 
    GETHeaderBase *fHeaderBase;
    GETBasicFrameHeader *fBasicFrameHeader;
@@ -137,6 +151,12 @@ private:
    Int_t fPrevDataID;       ///< Data ID for going back to original data
    ULong64_t fPrevPosition; ///< Byte number for going back to original data
 
+   Bool_t fUseMappedFiles;                                   ///< Flag for reading frames from mapped files
+   Bool_t fIsMappedIndexBuilt;                               ///< Flag for the mapped frame index being ready
+   std::vector<std::unique_ptr<GETMappedFile>> fMappedFiles; //! Mapped data files
+   std::vector<const uint8_t *> fMappedFrames;               //! Start of each frame in the mapped files
+   std::unordered_map<UInt_t, Int_t> fMappedEventIDs;        //! Event ID to frame ID in the mapped files
+
    ClassDef(GETDecoder2, 1); /// added for making dictionary by ROOT
 };
 
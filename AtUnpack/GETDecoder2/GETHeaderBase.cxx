@@ -93,6 +93,17 @@ void GETHeaderBase::Read(ifstream &stream, Bool_t rewind)
    stream.seekg((ULong64_t)stream.tellg() - GETHEADERBASESIZE * rewind);
 }
 
+void GETHeaderBase::Read(const uint8_t *data)
+{
+   Clear();
+
+   memcpy(&fMetaType, data, 1);
+   memcpy(fFrameSize, data + 1, 3);
+   memcpy(&fDataSource, data + 4, 1);
+   memcpy(fFrameType, data + 5, 2);
+   memcpy(&fRevision, data + 7, 1);
+}
+
 void GETHeaderBase::Print()
 {
    cout << showbase << hex;
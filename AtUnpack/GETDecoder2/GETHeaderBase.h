@@ -39,6 +39,8 @@ public:
 
    void Clear(Option_t * = "");
    void Read(ifstream &file, Bool_t rewind = kFALSE);
+   //! Read the header from memory (ex. a memory-mapped file) starting at **data**
+   void Read(const uint8_t *data);
 
    void Print();
 
@@ -85,6 +85,26 @@ void GETLayerHeader::Read(ifstream &stream)
    stream.ignore(GetHeaderSkip());
 }
 
+void GETLayerHeader::Read(const uint8_t *data)
+{
+   Clear();
+
+   GETHeaderBase::Read(data);
+   data += GETHEADERBASESIZE;
+
+   memcpy(fHeaderSize, data, 2);
+   memcpy(fItemSize, data + 2, 2);
+   memcpy(fNItems, data + 4, 4);
+   switch (GetFrameType()) {
+   case GETFRAMEMERGEDBYID: memcpy(fEventID, data + 8, 4); break;
+
+   case GETFRAMEMERGEDBYTIME:
+      memcpy(fEventTime, data + 8, 6);
+      memcpy(fDeltaT, data + 14, 2);
+      break;
+   }
+}
+
 void GETLayerHeader::Print()
 {
    cout << showbase << hex;
@@ -30,6 +30,7 @@ public:
 
    void Clear(Option_t * = "");
    void Read(ifstream &stream);
+   void Read(const uint8_t *data);
 
    void Print();
 
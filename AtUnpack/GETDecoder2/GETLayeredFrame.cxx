@@ -44,3 +44,18 @@ void GETLayeredFrame::Read(ifstream &stream)
       frame->Read(stream);
    }
 }
+
+void GETLayeredFrame::Read(const uint8_t *data)
+{
+   Clear();
+
+   GETLayerHeader::Read(data);
+
+   // Each basic frame follows the previous one, after the layer header
+   const uint8_t *frameData = data + GetHeaderSize();
+   for (Int_t iFrame = 0; iFrame < GetNItems(); iFrame++) {
+      auto *frame = (GETBasicFrame *)fFrames->ConstructedAt(iFrame);
+      frame->Read(frameData);
+      frameData += frame->GetFrameSize();
+   }
+}
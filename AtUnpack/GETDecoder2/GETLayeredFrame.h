@@ -5,6 +5,8 @@
 
 #include "GETLayerHeader.h"
 
+#include <stdint.h>
+
 #include <iosfwd>
 
 class GETBasicFrame;
@@ -23,6 +25,7 @@ public:
 
    void Clear(Option_t * = "");
    void Read(ifstream &stream);
+   void Read(const uint8_t *data);
 
 private:
    TClonesArray *fFrames;
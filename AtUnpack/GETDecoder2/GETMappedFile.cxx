@@ -0,0 +1,160 @@
+#include "GETMappedFile.h"
+
+#include <FairLogger.h>
+
+#include "GETBasicFrameHeader.h"
+#include "GETLayerHeader.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cstring>
+#include <fstream>
+#include <utility>
+
+namespace {
+// Layout of the sidecar index file header
+struct IndexFileHeader {
+   char fMagic[8];
+   ULong64_t fFileSize;
+   UInt_t fIsLayered;
+   UInt_t fReserved;
+   ULong64_t fNumFrames;
+};
+} // namespace
+
+GETMappedFile::GETMappedFile(TString filename) : fFileName(std::move(filename))
+{
+   int fd = open(fFileName.Data(), O_RDONLY);
+   if (fd < 0) {
+      LOG(error) << "== [GETMappedFile] Could not open " << fFileName;
+      return;
+   }
+
+   struct stat fileStat {};
+   if (fstat(fd, &fileStat) != 0 || fileStat.st_size == 0) {
+      LOG(error) << "== [GETMappedFile] Could not get size of " << fFileName;
+      close(fd);
+      return;
+   }
+   fSize = fileStat.st_size;
+
+   void *data = mmap(nullptr, fSize, PROT_READ, MAP_PRIVATE, fd, 0);
+   close(fd); // The mapping keeps its own reference to the file
+
+   if (data == MAP_FAILED) {
+      LOG(error) << "== [GETMappedFile] Could not map " << fFileName << " into memory";
+      fSize = 0;
+      return;
+   }
+
+   // Frames are usually read in order, so let the kernel read ahead aggressively
+   madvise(data, fSize, MADV_SEQUENTIAL);
+   fData = static_cast<const uint8_t *>(data);
+}
+
+GETMappedFile::~GETMappedFile()
+{
+   if (fData != nullptr)
+      munmap(const_cast<uint8_t *>(fData), fSize);
+}
+
+Bool_t GETMappedFile::LoadIndex(Bool_t isLayered)
+{
+   if (!IsOpen())
+      return kFALSE;
+
+   fIndex.clear();
+   if (ReadIndexFile(isLayered))
+      return kTRUE;
+
+   BuildIndex(isLayered);
+   WriteIndexFile(isLayered);
+   return kTRUE;
+}
+
+/**
+ * Walk the frame headers in the mapped file and record where each frame starts and ends.
+ * Stops at the first frame that is incomplete (ex. a file that is still being written).
+ */
+void GETMappedFile::BuildIndex(Bool_t isLayered)
+{
+   GETBasicFrameHeader basicHeader;
+   GETLayerHeader layerHeader;
+
+   const ULong64_t headerSize = isLayered ? GETLAYERHEADERBYTIMESIZE : GETBASICFRAMEHEADERSIZE;
+   ULong64_t startByte = 0;
+   while (startByte + headerSize <= fSize) {
+      ULong64_t frameSize = 0;
+      UInt_t eventID = 0;
+      if (isLayered) {
+         layerHeader.Read(GetData(startByte));
+         frameSize = layerHeader.GetFrameSize();
+         eventID = layerHeader.GetEventID();
+      } else {
+         basicHeader.Read(GetData(startByte));
+         frameSize = basicHeader.GetFrameSize();
+         eventID = basicHeader.GetEventID();
+      }
+
+      if (frameSize == 0 || startByte + frameSize > fSize) {
+         LOG(warn) << "== [GETMappedFile] Incomplete frame at byte " << startByte << " of " << fFileName
+                   << ". Ignoring the rest of the file.";
+         break;
+      }
+
+      // Topology frames are not data frames, so they are not indexed
+      if (!basicHeader.IsBlob() || isLayered)
+         fIndex.push_back({startByte, startByte + frameSize, eventID, 0});
+      startByte += frameSize;
+   }
+
+   LOG(info) << "== [GETMappedFile] Indexed " << fIndex.size() << " frames in " << fFileName;
+}
+
+Bool_t GETMappedFile::ReadIndexFile(Bool_t isLayered)
+{
+   std::ifstream file(GetIndexFileName().Data(), std::ios::binary);
+   if (!file.is_open())
+      return kFALSE;
+
+   IndexFileHeader header{};
+   file.read(reinterpret_cast<char *>(&header), sizeof(header));
+   if (!file || memcmp(header.fMagic, fIndexMagic, sizeof(fIndexMagic)) != 0 || header.fFileSize != fSize ||
+       header.fIsLayered != isLayered) {
+      LOG(info) << "== [GETMappedFile] Index " << GetIndexFileName() << " does not match data file, rebuilding it.";
+      return kFALSE;
+   }
+
+   fIndex.resize(header.fNumFrames);
+   file.read(reinterpret_cast<char *>(fIndex.data()), sizeof(FrameIndex) * fIndex.size());
+   if (!file) {
+      LOG(warn) << "== [GETMappedFile] Index " << GetIndexFileName() << " is truncated, rebuilding it.";
+      fIndex.clear();
+      return kFALSE;
+   }
+
+   LOG(info) << "== [GETMappedFile] Loaded index of " << fIndex.size() << " frames from " << GetIndexFileName();
+   return kTRUE;
+}
+
+void GETMappedFile::WriteIndexFile(Bool_t isLayered)
+{
+   std::ofstream file(GetIndexFileName().Data(), std::ios::binary | std::ios::trunc);
+   if (!file.is_open()) {
+      LOG(warn) << "== [GETMappedFile] Could not write index " << GetIndexFileName()
+                << ". It will be rebuilt next time the file is opened.";
+      return;
+   }
+
+   IndexFileHeader header{};
+   memcpy(header.fMagic, fIndexMagic, sizeof(fIndexMagic));
+   header.fFileSize = fSize;
+   header.fIsLayered = isLayered;
+   header.fNumFrames = fIndex.size();
+
+   file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+   file.write(reinterpret_cast<const char *>(fIndex.data()), sizeof(FrameIndex) * fIndex.size());
+}
@@ -0,0 +1,65 @@
+// =================================================
+//  GETMappedFile Class
+//
+//  Description:
+//    Read-only memory map of a GRAW file together with
+//    an index of the byte range and event ID of every
+//    frame in the file. The index is built once by
+//    walking the frame headers and is cached next to
+//    the data in a sidecar file (<filename>.idx) so
+//    reopening a file does not require a rescan.
+// =================================================
+
+#ifndef GETMAPPEDFILE
+#define GETMAPPEDFILE
+
+#include <Rtypes.h>
+#include <TString.h>
+
+#include <stdint.h>
+
+#include <vector>
+
+class GETMappedFile {
+public:
+   //! Location of a single frame in the mapped file
+   struct FrameIndex {
+      ULong64_t fStartByte;
+      ULong64_t fEndByte;
+      UInt_t fEventID;
+      UInt_t fReserved;
+   };
+
+   //! Map the file **filename** into memory. Check IsOpen() for success.
+   GETMappedFile(TString filename);
+   ~GETMappedFile();
+
+   GETMappedFile(const GETMappedFile &) = delete;
+   GETMappedFile &operator=(const GETMappedFile &) = delete;
+
+   Bool_t IsOpen() const { return fData != nullptr; }
+   const TString &GetFileName() const { return fFileName; }
+   ULong64_t GetSize() const { return fSize; }
+   //! Return a pointer to the byte **startByte** in the mapped file
+   const uint8_t *GetData(ULong64_t startByte = 0) const { return fData + startByte; }
+
+   //! Load the frame index from the sidecar file, or build and save it if the sidecar is missing or stale.
+   //! **isLayered** selects if the frames are merged (layered) frames or basic frames.
+   Bool_t LoadIndex(Bool_t isLayered);
+   const std::vector<FrameIndex> &GetIndex() const { return fIndex; }
+
+private:
+   void BuildIndex(Bool_t isLayered);
+   Bool_t ReadIndexFile(Bool_t isLayered);
+   void WriteIndexFile(Bool_t isLayered);
+   TString GetIndexFileName() const { return fFileName + ".idx"; }
+
+   TString fFileName;
+   const uint8_t *fData{nullptr}; ///< Start of the mapped file
+   ULong64_t fSize{0};            ///< Size of the mapped file in bytes
+   std::vector<FrameIndex> fIndex;
+
+   static constexpr char fIndexMagic[8] = {'G', 'E', 'T', 'I', 'D', 'X', '0', '1'};
+};
+
+#endif